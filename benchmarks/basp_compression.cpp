@@ -0,0 +1,131 @@
+// Measures bytes on the wire and CPU cost of compressing batches of BASP
+// messages. Each batch consists of `batch` dispatch messages serialized the
+// same way the BASP broker writes them to a connection. The workloads cover
+// short messages dominated by type names, text and numeric arrays.
+//
+// Example:
+// - basp_compression --batch=64 --rounds=200
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <functional>
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+#include "caf/io/basp/lz_codec.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+
+using namespace caf;
+using namespace caf::io::basp;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using fsec = std::chrono::duration<double>;
+
+using ping_atom = atom_constant<atom("ping")>;
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(batch, "batch", "number of messages per batch")
+    .add(rounds, "rounds", "number of times each batch gets (de)compressed");
+    add_message_type<std::vector<int32_t>>("std::vector<int32_t>");
+    add_message_type<std::vector<double>>("std::vector<double>");
+  }
+  size_t batch = 64;
+  size_t rounds = 200;
+};
+
+// Appends `num` dispatch messages generated by `f` to `buf`.
+void make_batch(actor_system& sys, size_t num, buffer_type& buf,
+                const std::function<message (size_t)>& f) {
+  for (size_t i = 0; i < num; ++i) {
+    auto msg = f(i);
+    std::vector<strong_actor_ptr> stages;
+    auto writer = make_callback([&](serializer& sink) -> error {
+      return sink(stages, msg);
+    });
+    header hdr{message_type::dispatch_message, 0, 0, i, sys.node(),
+               sys.node(), 42, 23};
+    instance::write(sys.dummy_execution_unit(), buf, hdr, &writer);
+  }
+}
+
+void run(codec& c, const config& cfg, const char* name,
+         const buffer_type& batch) {
+  buffer_type compressed;
+  buffer_type decompressed;
+  auto t0 = clock_type::now();
+  for (size_t i = 0; i < cfg.rounds; ++i) {
+    compressed.clear();
+    c.compress(batch.data(), batch.size(), compressed);
+  }
+  auto t1 = clock_type::now();
+  for (size_t i = 0; i < cfg.rounds; ++i) {
+    decompressed.clear();
+    if (!c.decompress(compressed.data(), compressed.size(), batch.size(),
+                      decompressed)) {
+      cerr << "*** " << name << ": decompression failed" << endl;
+      return;
+    }
+  }
+  auto t2 = clock_type::now();
+  auto mb = static_cast<double>(batch.size() * cfg.rounds) / 1e6;
+  auto comp_secs = std::chrono::duration_cast<fsec>(t1 - t0).count();
+  auto decomp_secs = std::chrono::duration_cast<fsec>(t2 - t1).count();
+  cout << std::left << std::setw(8) << name << std::right
+       << std::setw(9) << batch.size() << " -> " << std::setw(9)
+       << compressed.size() << " bytes (" << std::fixed
+       << std::setprecision(2)
+       << (static_cast<double>(batch.size()) / compressed.size()) << "x), "
+       << "compress " << std::setprecision(1) << (mb / comp_secs)
+       << " MB/s, decompress " << (mb / decomp_secs) << " MB/s" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  config cfg;
+  cfg.parse(argc, argv);
+  if (cfg.cli_helptext_printed)
+    return 0;
+  actor_system sys{cfg};
+  lz_codec c;
+  buffer_type buf;
+  make_batch(sys, cfg.batch, buf, [](size_t i) {
+    return make_message(ping_atom::value, static_cast<int32_t>(i));
+  });
+  run(c, cfg, "atoms", buf);
+  buf.clear();
+  make_batch(sys, cfg.batch, buf, [](size_t i) {
+    return make_message("sensor-" + std::to_string(i % 8),
+                        std::string{"status: ok, temperature within range"});
+  });
+  run(c, cfg, "strings", buf);
+  buf.clear();
+  make_batch(sys, cfg.batch, buf, [](size_t i) {
+    std::vector<int32_t> xs(256);
+    for (size_t j = 0; j < xs.size(); ++j)
+      xs[j] = static_cast<int32_t>((i + j) % 100);
+    return make_message(std::move(xs));
+  });
+  run(c, cfg, "numbers", buf);
+  buf.clear();
+  make_batch(sys, cfg.batch, buf, [](size_t i) {
+    std::vector<double> xs(64);
+    for (size_t j = 0; j < xs.size(); ++j)
+      xs[j] = static_cast<double>(i * j) / 3.;
+    return make_message(std::move(xs));
+  });
+  run(c, cfg, "doubles", buf);
+  return 0;
+}
@@ -0,0 +1,102 @@
+// Measures BASP throughput between two actor systems over the loopback
+// device, once with small (64 bytes) and once with large (64 KB) messages.
+//
+// Options for the middleman apply to both nodes, e.g.:
+// - basp_throughput --middleman.flush-threshold=65536
+// - basp_throughput --middleman.unix-socket-dir=/tmp (Unix domain sockets)
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using payload = std::vector<char>;
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(num_small, "num-small", "number of 64 byte messages")
+    .add(num_large, "num-large", "number of 64 KB messages");
+  }
+  size_t num_small = 100000;
+  size_t num_large = 2000;
+};
+
+// Counts all received bytes and reports them on request.
+behavior sink(stateful_actor<size_t>* self) {
+  self->state = 0;
+  return {
+    [=](const payload& xs) {
+      self->state += xs.size();
+    },
+    [=](get_atom) {
+      auto result = self->state;
+      self->state = 0;
+      return result;
+    }
+  };
+}
+
+void run(actor_system& sys, const actor& dest, size_t num, size_t size) {
+  scoped_actor self{sys};
+  payload xs(size, 'x');
+  auto t0 = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < num; ++i)
+    self->send(dest, xs);
+  // Messages from the same sender arrive in order, i.e., the sink has
+  // received all messages once it responds to this request.
+  self->request(dest, infinite, get_atom::value).receive(
+    [&](size_t received) {
+      using fsec = std::chrono::duration<double>;
+      auto t1 = std::chrono::steady_clock::now();
+      auto secs = std::chrono::duration_cast<fsec>(t1 - t0).count();
+      cout << std::setw(6) << size << " bytes: "
+           << std::fixed << std::setprecision(2)
+           << (num / secs) << " msg/s, "
+           << (received / secs / (1024 * 1024)) << " MB/s" << endl;
+    },
+    [&](error& err) {
+      cerr << "*** benchmark failed: " << sys.render(err) << endl;
+    }
+  );
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  config server_cfg;
+  server_cfg.load<io::middleman>().parse(argc, argv);
+  if (server_cfg.cli_helptext_printed)
+    return 0;
+  config client_cfg;
+  client_cfg.load<io::middleman>().parse(argc, argv);
+  actor_system server_sys{server_cfg};
+  actor_system client_sys{client_cfg};
+  auto port = server_sys.middleman().publish(server_sys.spawn(sink), 0,
+                                             "127.0.0.1");
+  if (!port) {
+    cerr << "*** publish failed: " << server_sys.render(port.error()) << endl;
+    return 1;
+  }
+  auto dest = client_sys.middleman().remote_actor("127.0.0.1", *port);
+  if (!dest) {
+    cerr << "*** connect failed: " << client_sys.render(dest.error()) << endl;
+    return 1;
+  }
+  run(client_sys, *dest, client_cfg.num_small, 64);
+  run(client_sys, *dest, client_cfg.num_large, 64 * 1024);
+  anon_send_exit(*dest, exit_reason::user_shutdown);
+  return 0;
+}
@@ -0,0 +1,109 @@
+// Measures how fast a single source broadcasts a stream of strings to 1, 10
+// and 100 sinks, once with a copy of each batch per sink and once with
+// batches that all sinks share. The sinks only read their input.
+//
+// Example:
+// - broadcast_fanout --num=100000 --size=64
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(num, "num", "number of elements per run")
+    .add(size, "size", "size of a single element in bytes");
+  }
+  size_t num = 100000;
+  size_t size = 64;
+};
+
+behavior sink(event_based_actor* self, actor listener) {
+  return {
+    [=](const stream<std::string>& in) {
+      return self->make_sink(
+        in,
+        [](size_t& bytes) {
+          bytes = 0;
+        },
+        [](size_t& bytes, const std::string& x) {
+          bytes += x.size();
+        },
+        [=](size_t&, const error&) {
+          self->send(listener, ok_atom::value);
+        }
+      );
+    }
+  };
+}
+
+void source(event_based_actor* self, std::vector<actor> sinks, size_t num,
+            size_t size, bool shared) {
+  auto res = self->make_source(
+    sinks.front(),
+    [](size_t& pushed) {
+      pushed = 0;
+    },
+    [=](size_t& pushed, downstream<std::string>& out, size_t hint) {
+      auto n = std::min(hint, num - pushed);
+      for (size_t i = 0; i < n; ++i)
+        out.push(std::string(size, 'x'));
+      pushed += n;
+    },
+    [=](const size_t& pushed) {
+      return pushed == num;
+    }
+  );
+  for (size_t i = 1; i < sinks.size(); ++i)
+    res.ptr()->add_unchecked_outbound_path<std::string>(sinks[i]);
+  res.ptr()->out().shared_batches(shared);
+}
+
+void run(actor_system& sys, const config& cfg, size_t num_sinks,
+         bool shared) {
+  scoped_actor self{sys};
+  std::vector<actor> sinks;
+  for (size_t i = 0; i < num_sinks; ++i)
+    sinks.emplace_back(sys.spawn(sink, actor{self}));
+  auto t0 = clock_type::now();
+  sys.spawn(source, sinks, cfg.num, cfg.size, shared);
+  size_t done = 0;
+  self->receive_for(done, num_sinks)([](ok_atom) {
+    // nop
+  });
+  auto t1 = clock_type::now();
+  using fsec = std::chrono::duration<double>;
+  auto secs = std::chrono::duration_cast<fsec>(t1 - t0).count();
+  cout << std::setw(3) << num_sinks << " sinks, "
+       << (shared ? "shared" : "copied") << " batches: " << std::fixed
+       << std::setprecision(3) << secs << " s, " << std::setprecision(0)
+       << (cfg.num / secs) << " elements/s" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  config cfg;
+  cfg.parse(argc, argv);
+  if (cfg.cli_helptext_printed)
+    return 0;
+  actor_system sys{cfg};
+  for (size_t num_sinks : {1, 10, 100})
+    for (bool shared : {false, true})
+      run(sys, cfg, num_sinks, shared);
+  return 0;
+}
@@ -0,0 +1,179 @@
+// Compares processing steps of a stream stage over batches stored as rows,
+// i.e., `std::vector<tick>`, and as columns, i.e., `column_batch<tick>`. The
+// sum step adds up a single field, the filter step keeps all ticks above a
+// price threshold, and the projection step computes a new value from two
+// fields. The serialize step measures the cost of converting a batch to the
+// binary format BASP sends over the network.
+//
+// Example:
+// - columnar_batch --batch=1024 --rounds=2000
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <functional>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct tick {
+  int64_t time;
+  double price;
+  double volume;
+  int32_t venue;
+  int32_t flags;
+};
+
+template <class Inspector>
+typename Inspector::result_type inspect(Inspector& f, tick& x) {
+  return f(meta::type_name("tick"), x.time, x.price, x.volume, x.venue,
+           x.flags);
+}
+
+using rows = std::vector<tick>;
+
+using columns = column_batch<tick>;
+
+constexpr double threshold = 100.;
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(batch, "batch", "number of elements per batch")
+    .add(rounds, "rounds", "number of times each step processes the batch");
+  }
+  size_t batch = 1024;
+  size_t rounds = 2000;
+};
+
+// Keeps the compiler from optimizing away the results.
+volatile double sink_value;
+
+rows make_rows(size_t n) {
+  rows result;
+  for (size_t i = 0; i < n; ++i)
+    result.push_back(tick{static_cast<int64_t>(i), 50. + (i * 7919 % 100),
+                          static_cast<double>(i % 13),
+                          static_cast<int32_t>(i % 4), 0});
+  return result;
+}
+
+template <class T>
+void gather(const columns& in, columns& out, size_t col,
+            const std::vector<uint32_t>& indexes) {
+  auto src = in.column<T>(col);
+  auto dst = out.column<T>(col);
+  for (size_t i = 0; i < indexes.size(); ++i)
+    dst[i] = src[indexes[i]];
+}
+
+double run(const config& cfg, const std::function<void ()>& f) {
+  auto t0 = clock_type::now();
+  for (size_t i = 0; i < cfg.rounds; ++i)
+    f();
+  auto t1 = clock_type::now();
+  using fnsec = std::chrono::duration<double, std::nano>;
+  auto ns = std::chrono::duration_cast<fnsec>(t1 - t0).count();
+  return ns / static_cast<double>(cfg.rounds * cfg.batch);
+}
+
+void print(const char* step, double row_ns, double col_ns) {
+  cout << std::left << std::setw(10) << step << std::right << std::fixed
+       << std::setprecision(2) << "rows " << std::setw(7) << row_ns
+       << " ns/element, columns " << std::setw(7) << col_ns
+       << " ns/element (" << (row_ns / col_ns) << "x)" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  config cfg;
+  cfg.parse(argc, argv);
+  if (cfg.cli_helptext_printed)
+    return 0;
+  actor_system sys{cfg};
+  auto xs = make_rows(cfg.batch);
+  columns ys{xs.begin(), xs.end()};
+  // Sum.
+  auto row_ns = run(cfg, [&] {
+    double sum = 0;
+    for (auto& x : xs)
+      sum += x.price;
+    sink_value = sum;
+  });
+  auto col_ns = run(cfg, [&] {
+    double sum = 0;
+    for (auto x : ys.column<double>(1))
+      sum += x;
+    sink_value = sum;
+  });
+  print("sum", row_ns, col_ns);
+  // Filter.
+  rows row_out;
+  row_ns = run(cfg, [&] {
+    row_out.clear();
+    for (auto& x : xs)
+      if (x.price > threshold)
+        row_out.push_back(x);
+    sink_value = static_cast<double>(row_out.size());
+  });
+  columns col_out;
+  std::vector<uint32_t> indexes;
+  col_ns = run(cfg, [&] {
+    indexes.clear();
+    auto prices = ys.column<double>(1);
+    for (size_t i = 0; i < prices.size(); ++i)
+      if (prices[i] > threshold)
+        indexes.push_back(static_cast<uint32_t>(i));
+    col_out.resize(indexes.size());
+    gather<int64_t>(ys, col_out, 0, indexes);
+    gather<double>(ys, col_out, 1, indexes);
+    gather<double>(ys, col_out, 2, indexes);
+    gather<int32_t>(ys, col_out, 3, indexes);
+    gather<int32_t>(ys, col_out, 4, indexes);
+    sink_value = static_cast<double>(col_out.rows());
+  });
+  print("filter", row_ns, col_ns);
+  // Projection.
+  std::vector<double> notional(cfg.batch);
+  row_ns = run(cfg, [&] {
+    for (size_t i = 0; i < xs.size(); ++i)
+      notional[i] = xs[i].price * xs[i].volume;
+    sink_value = notional.back();
+  });
+  col_ns = run(cfg, [&] {
+    auto prices = ys.column<double>(1);
+    auto volumes = ys.column<double>(2);
+    for (size_t i = 0; i < prices.size(); ++i)
+      notional[i] = prices[i] * volumes[i];
+    sink_value = notional.back();
+  });
+  print("project", row_ns, col_ns);
+  // Serialization.
+  std::vector<char> buf;
+  row_ns = run(cfg, [&] {
+    buf.clear();
+    binary_serializer sink{sys, buf};
+    sink(xs);
+    sink_value = static_cast<double>(buf.size());
+  });
+  col_ns = run(cfg, [&] {
+    buf.clear();
+    binary_serializer sink{sys, buf};
+    sink(ys);
+    sink_value = static_cast<double>(buf.size());
+  });
+  print("serialize", row_ns, col_ns);
+  return 0;
+}
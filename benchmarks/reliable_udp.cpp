@@ -0,0 +1,214 @@
+// Measures goodput and latency of the sliding window for reliable BASP over
+// UDP on a simulated link with 0% to 5% random loss. The link has a fixed
+// bandwidth, a fixed propagation delay and a drop-tail queue, i.e., the
+// window also loses datagrams when sending faster than the link admits.
+// Acknowledgements travel over the same kind of link in reverse direction.
+// The simulation runs in virtual time, hence results are deterministic and
+// independent of the host.
+//
+// Example:
+// - reliable_udp --num=100000 --rtt=20 --window=32
+
+#include <set>
+#include <deque>
+#include <random>
+#include <numeric>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+
+#include "caf/all.hpp"
+#include "caf/io/basp/sliding_window.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+using namespace caf::io::basp;
+
+namespace {
+
+using std::chrono::microseconds;
+using std::chrono::duration_cast;
+
+using time_point = sliding_window::time_point;
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(num, "num", "number of datagrams per run")
+    .add(size, "size", "size of a single datagram in bytes")
+    .add(rtt, "rtt", "round-trip propagation delay in milliseconds")
+    .add(bandwidth, "bandwidth", "link bandwidth in Mbit/s")
+    .add(queue, "queue", "capacity of the drop-tail queue in datagrams")
+    .add(window, "window", "maximum number of datagrams in flight");
+  }
+  size_t num = 20000;
+  size_t size = 1024;
+  size_t rtt = 10;
+  size_t bandwidth = 100;
+  size_t queue = 32;
+  size_t window = sliding_window::max_window;
+};
+
+// A unidirectional link with bandwidth, delay, random loss and a drop-tail
+// queue in front of the bottleneck.
+class lossy_link {
+public:
+  lossy_link(const config& cfg, double loss, uint32_t seed)
+      : tx_time_(cfg.size * 8 / cfg.bandwidth),
+        delay_(cfg.rtt * 500),
+        capacity_(cfg.queue),
+        loss_(loss),
+        engine_(seed) {
+    // nop
+  }
+
+  void send(buffer_type buf, time_point now) {
+    if (dist_(engine_) < loss_ || queued_ >= capacity_)
+      return;
+    // The datagram leaves the queue once all previous datagrams did.
+    busy_until_ = std::max(busy_until_, now) + tx_time_;
+    ++queued_;
+    transit_.push_back(entry{busy_until_, busy_until_ + delay_,
+                             std::move(buf)});
+  }
+
+  template <class F>
+  void deliver(time_point now, F f) {
+    while (!transit_.empty() && transit_.front().arrival <= now) {
+      auto buf = std::move(transit_.front().buf);
+      transit_.pop_front();
+      f(buf);
+    }
+    queued_ = static_cast<size_t>(
+      std::count_if(transit_.begin(), transit_.end(),
+                    [&](const entry& x) { return x.departure > now; }));
+  }
+
+private:
+  struct entry {
+    time_point departure;
+    time_point arrival;
+    buffer_type buf;
+  };
+
+  microseconds tx_time_;
+  microseconds delay_;
+  size_t capacity_;
+  double loss_;
+  std::minstd_rand engine_;
+  std::uniform_real_distribution<double> dist_;
+  time_point busy_until_;
+  size_t queued_ = 0;
+  std::deque<entry> transit_;
+};
+
+buffer_type make_datagram(sequence_type seq, size_t size) {
+  buffer_type result(std::max(size, size_t{2}));
+  result[0] = static_cast<char>(seq >> 8);
+  result[1] = static_cast<char>(seq & 0xFF);
+  return result;
+}
+
+sequence_type seq_of(const buffer_type& buf) {
+  return static_cast<sequence_type>((static_cast<uint8_t>(buf[0]) << 8)
+                                    | static_cast<uint8_t>(buf[1]));
+}
+
+void run(const config& cfg, double loss) {
+  sliding_window win{cfg.window};
+  lossy_link data{cfg, loss, 1};
+  lossy_link acks{cfg, loss, 2};
+  time_point start;
+  auto now = start;
+  // Sender side.
+  std::vector<time_point> pushed_at;
+  pushed_at.reserve(cfg.num);
+  auto send = [&](const buffer_type& buf) { data.send(buf, now); };
+  // Receiver side, storing early datagrams by their index.
+  sequence_type next = 0;
+  std::set<size_t> pending;
+  size_t delivered = 0;
+  std::vector<microseconds> latencies;
+  latencies.reserve(cfg.num);
+  auto after = [](sequence_type x, sequence_type y) {
+    return static_cast<int16_t>(static_cast<sequence_type>(x - y)) > 0;
+  };
+  auto deliver = [&] {
+    latencies.push_back(duration_cast<microseconds>(now
+                                                    - pushed_at[delivered]));
+    ++delivered;
+    ++next;
+  };
+  while (delivered < cfg.num) {
+    now += microseconds(10);
+    // Keep a small backlog in the window, like a busy BASP broker would.
+    while (pushed_at.size() < cfg.num && win.backlog() < 4) {
+      auto seq = static_cast<sequence_type>(pushed_at.size());
+      pushed_at.push_back(now);
+      win.push(seq, make_datagram(seq, cfg.size), now, send);
+    }
+    data.deliver(now, [&](const buffer_type& buf) {
+      auto seq = seq_of(buf);
+      if (seq == next) {
+        deliver();
+        for (auto i = pending.begin();
+             i != pending.end() && *i == delivered;
+             i = pending.erase(i))
+          deliver();
+      } else if (after(seq, next)) {
+        pending.emplace(delivered + static_cast<sequence_type>(seq - next));
+      }
+      uint64_t sack = 0;
+      for (auto x : pending)
+        sack |= uint64_t{1} << (x - delivered - 1);
+      // Acknowledgements have the size of a BASP header.
+      auto ack = make_datagram(next, header_size);
+      for (size_t i = 0; i < 8; ++i)
+        ack[2 + i] = static_cast<char>(sack >> (i * 8));
+      acks.send(std::move(ack), now);
+    });
+    acks.deliver(now, [&](const buffer_type& buf) {
+      uint64_t sack = 0;
+      for (size_t i = 0; i < 8; ++i)
+        sack |= uint64_t{static_cast<uint8_t>(buf[2 + i])} << (i * 8);
+      win.ack(seq_of(buf), sack, now, send);
+    });
+    auto deadline = win.deadline();
+    if (deadline && *deadline <= now)
+      win.timeout(now, send);
+  }
+  using fsec = std::chrono::duration<double>;
+  auto secs = duration_cast<fsec>(now - start).count();
+  std::sort(latencies.begin(), latencies.end());
+  auto avg = std::accumulate(latencies.begin(), latencies.end(),
+                             microseconds{0}) / latencies.size();
+  auto p99 = latencies[latencies.size() * 99 / 100];
+  cout << std::fixed << std::setprecision(1)
+       << "loss " << (loss * 100) << "%: "
+       << (cfg.num * cfg.size * 8 / secs / 1e6) << " Mbit/s goodput, "
+       << "latency avg " << (avg.count() / 1000.) << " ms, "
+       << "p99 " << (p99.count() / 1000.) << " ms, "
+       << win.retransmissions() << " retransmissions" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  config cfg;
+  cfg.parse(argc, argv);
+  if (cfg.cli_helptext_printed)
+    return 0;
+  if (cfg.bandwidth == 0 || cfg.num == 0)
+    return 1;
+  cout << cfg.num << " datagrams with " << cfg.size << " bytes over a "
+       << cfg.bandwidth << " Mbit/s link with " << cfg.rtt << " ms RTT"
+       << endl;
+  for (auto loss : {0., 0.01, 0.02, 0.05})
+    run(cfg, loss);
+  return 0;
+}
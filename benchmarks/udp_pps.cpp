@@ -0,0 +1,174 @@
+// Measures how many datagrams per second a broker receives from another broker
+// over the loopback device. The brokers run on separate multiplexer threads.
+// The receiver grants credit to the sender after each burst to avoid
+// overflowing the socket buffer and stops measuring once it received all
+// datagrams or after not receiving any datagram for a second.
+//
+// Options for the middleman apply to both brokers, e.g.:
+// - udp_pps --middleman.datagram-batch-size=32
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+
+using namespace caf;
+using namespace caf::io;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using send_atom = atom_constant<atom("send")>;
+
+using credit_atom = atom_constant<atom("credit")>;
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(num, "num", "number of datagrams")
+    .add(size, "size", "size of a single datagram in bytes")
+    .add(burst, "burst", "number of datagrams the sender writes at once")
+    .add(window, "window", "maximum number of datagrams in flight");
+    set("middleman.multiplexer-threads", 2);
+  }
+  size_t num = 1000000;
+  size_t size = 64;
+  size_t burst = 32;
+  size_t window = 128;
+};
+
+struct receiver_state {
+  size_t received = 0;
+  clock_type::time_point first;
+  clock_type::time_point last;
+  actor sender;
+};
+
+// Counts received datagrams and reports the result to `listener`.
+behavior receiver(stateful_actor<receiver_state, broker>* self, size_t num,
+                  size_t burst, actor listener) {
+  auto report = [=] {
+    using fsec = std::chrono::duration<double>;
+    auto& st = self->state;
+    auto secs = std::chrono::duration_cast<fsec>(st.last - st.first).count();
+    self->send(listener, st.received, secs);
+    self->quit();
+  };
+  return {
+    [=](publish_atom) -> expected<uint16_t> {
+      auto res = self->add_udp_datagram_servant(0, "127.0.0.1");
+      if (!res)
+        return std::move(res.error());
+      return res->second;
+    },
+    [=](const actor& sender) {
+      self->state.sender = sender;
+    },
+    [=](const new_datagram_msg&) {
+      auto& st = self->state;
+      st.last = clock_type::now();
+      if (st.received++ == 0)
+        st.first = st.last;
+      if (st.received == num)
+        report();
+      else if (st.received % burst == 0)
+        self->send(st.sender, credit_atom::value, burst);
+    },
+    after(std::chrono::seconds(1)) >> [=] {
+      if (self->state.received > 0)
+        report();
+    }
+  };
+}
+
+struct sender_state {
+  size_t remaining;
+  size_t in_flight = 0;
+};
+
+// Writes `num` datagrams with `size` bytes in bursts of `burst` datagrams
+// while having at most `window` datagrams in flight.
+behavior sender(stateful_actor<sender_state, broker>* self, uint16_t port,
+                size_t num, size_t size, size_t burst, size_t window) {
+  auto hdl = self->add_udp_datagram_servant("127.0.0.1", port);
+  if (!hdl) {
+    cerr << "*** cannot open UDP socket: "
+         << self->system().render(hdl.error()) << endl;
+    return {};
+  }
+  self->state.remaining = num;
+  return {
+    [=](send_atom) {
+      auto& st = self->state;
+      auto n = std::min(std::min(burst, st.remaining), window - st.in_flight);
+      for (size_t i = 0; i < n; ++i)
+        self->enqueue_datagram(*hdl, std::vector<char>(size, 'x'));
+      self->flush(*hdl);
+      st.remaining -= n;
+      st.in_flight += n;
+      if (st.remaining > 0 && st.in_flight < window)
+        self->send(self, send_atom::value);
+    },
+    [=](credit_atom, size_t n) {
+      auto& st = self->state;
+      auto was_blocked = st.in_flight == window;
+      st.in_flight -= n;
+      if (was_blocked && st.remaining > 0)
+        self->send(self, send_atom::value);
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  config cfg;
+  cfg.load<io::middleman>().parse(argc, argv);
+  if (cfg.cli_helptext_printed)
+    return 0;
+  actor_system sys{cfg};
+  auto& mm = sys.middleman();
+  scoped_actor self{sys};
+  auto rcv = mm.spawn_broker(receiver, cfg.num, cfg.burst, actor{self});
+  actor snd;
+  self->request(rcv, infinite, publish_atom::value).receive(
+    [&](uint16_t port) {
+      snd = mm.spawn_broker(sender, port, cfg.num, cfg.size, cfg.burst,
+                            cfg.window);
+    },
+    [&](error& err) {
+      cerr << "*** cannot open UDP port: " << sys.render(err) << endl;
+    }
+  );
+  if (!snd)
+    return 1;
+  // Start sending once the receiver knows where to send credit.
+  self->request(rcv, infinite, snd).receive(
+    [] {
+      // nop
+    },
+    [&](error& err) {
+      cerr << "*** receiver failed: " << sys.render(err) << endl;
+    }
+  );
+  self->send(snd, send_atom::value);
+  self->receive(
+    [&](size_t received, double secs) {
+      cout << "received " << received << " of " << cfg.num
+           << " datagrams (" << cfg.size << " bytes): "
+           << std::fixed << std::setprecision(2)
+           << (secs > 0 ? received / secs : 0.) << " datagrams/s" << endl;
+    }
+  );
+  anon_send_exit(snd, exit_reason::user_shutdown);
+  return 0;
+}
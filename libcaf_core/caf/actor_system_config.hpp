@@ -53,6 +53,10 @@ public:
 
   using hook_factory_vector = std::vector<hook_factory>;
 
+  using codec_factory = std::function<io::basp::codec* ()>;
+
+  using codec_factory_vector = std::vector<codec_factory>;
+
   using thread_hooks = std::vector<std::unique_ptr<thread_hook>>;
 
   template <class K, class V>
@@ -234,6 +238,16 @@ public:
     });
   }
 
+  /// Adds a compression codec for BASP connections to the middleman (if
+  /// loaded). Nodes select a codec by name via `middleman.compression`.
+  template <class Codec>
+  actor_system_config& add_codec_type() {
+    codec_factories.push_back([]() -> io::basp::codec* {
+      return new Codec;
+    });
+    return *this;
+  }
+
   /// Adds a hook type to the scheduler.
   template <class Hook, class... Ts>
   actor_system_config& add_thread_hook(Ts&&... ts) {
@@ -341,6 +355,7 @@ public:
   actor_factory_map actor_factories;
   module_factory_vector module_factories;
   hook_factory_vector hook_factories;
+  codec_factory_vector codec_factories;
   group_module_factory_vector group_module_factories;
 
   // -- hooks ------------------------------------------------------------------
@@ -61,6 +61,7 @@
 #include "caf/thread_hook.hpp"
 #include "caf/typed_actor.hpp"
 #include "caf/actor_system.hpp"
+#include "caf/column_batch.hpp"
 #include "caf/config_value.hpp"
 #include "caf/deserializer.hpp"
 #include "caf/scoped_actor.hpp"
@@ -104,6 +105,7 @@
 #include "caf/typed_response_promise.hpp"
 #include "caf/typed_event_based_actor.hpp"
 #include "caf/fused_downstream_manager.hpp"
+#include "caf/columnar_downstream_manager.hpp"
 #include "caf/abstract_composable_behavior.hpp"
 
 #include "caf/decorator/sequencer.hpp"
@@ -184,6 +184,12 @@ using receive_atom = atom_constant<atom("receive")>;
 /// Used as timeout type for `timeout_msg`.
 using stream_atom = atom_constant<atom("stream")>;
 
+/// Used for adding connections to an already connected node.
+using lane_atom = atom_constant<atom("lane")>;
+
+/// Used for triggering retransmissions of unacknowledged datagrams.
+using retransmit_atom = atom_constant<atom("retransmit")>;
+
 } // namespace caf
 
 namespace std {
@@ -19,6 +19,9 @@
 #pragma once
 
 #include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
 
 #include "caf/buffered_downstream_manager.hpp"
 #include "caf/outbound_path.hpp"
@@ -59,7 +62,9 @@ public:
 
   // -- constructors, destructors, and assignment operators --------------------
 
-  broadcast_downstream_manager(stream_manager* parent) : super(parent) {
+  broadcast_downstream_manager(stream_manager* parent)
+      : super(parent),
+        shared_batches_(false) {
     // nop
   }
 
@@ -147,6 +152,21 @@ public:
     return select_;
   }
 
+  /// Returns whether all paths share the same batches.
+  bool shared_batches() const noexcept {
+    return shared_batches_;
+  }
+
+  /// Enables or disables sharing batches between all paths. When enabled,
+  /// the manager builds each batch only once and sends the same immutable
+  /// message to all paths instead of copying the elements into per-path
+  /// buffers. Shared batches use the smallest desired batch size of all paths
+  /// and leave elements in the central buffer until all paths have credit for
+  /// them. Has no effect unless `Select` is `detail::select_all`.
+  void shared_batches(bool value) noexcept {
+    shared_batches_ = value;
+  }
+
   // -- overridden functions ---------------------------------------------------
 
   bool insert_path(unique_path_ptr ptr) override {
@@ -219,6 +239,11 @@ private:
     CAF_ASSERT(this->paths_.size() <= state_map_.size());
     if (this->paths_.empty())
       return;
+    // TODO: replace with `if constexpr` when switching to C++17
+    if (shared_batches_
+        && std::is_same<select_type, detail::select_all>::value
+        && emit_shared_batches(force_underfull))
+      return;
     // Calculate the chunk size, i.e., how many more items we can put to our
     // caches at the most.
     auto not_closing = [&](typename map_type::value_type& x,
@@ -241,7 +266,8 @@ private:
       auto g = [&](typename map_type::value_type& x,
                    typename state_map_type::value_type& y) {
         // Always force batches on closing paths.
-        x.second->emit_batches(this->self(), y.second.buf, true);
+        x.second->emit_batches(this->self(), y.second.buf, true,
+                               *this);
       };
       detail::zip_foreach(g, this->paths_.container(), state_map_.container());
       return;
@@ -253,7 +279,8 @@ private:
                    typename state_map_type::value_type& y) {
         // Always force batches on closing paths.
         x.second->emit_batches(this->self(), y.second.buf,
-                               force_underfull || x.second->closing);
+                               force_underfull || x.second->closing,
+                               *this);
       };
       detail::zip_foreach(g, this->paths_.container(), state_map_.container());
     } else {
@@ -274,14 +301,81 @@ private:
         }
         // Always force batches on closing paths.
         x.second->emit_batches(this->self(), st.buf,
-                               force_underfull || x.second->closing);
+                               force_underfull || x.second->closing,
+                               *this);
       };
       detail::zip_foreach(g, this->paths_.container(), state_map_.container());
     }
   }
 
+  /// Ships batches from the central buffer as messages shared by all paths.
+  /// Returns `false` if some path still has elements in its own buffer, in
+  /// which case the caller must fall back to per-path buffers in order to
+  /// preserve the ordering.
+  bool emit_shared_batches(bool force_underfull) {
+    auto self = this->self();
+    // Drain leftovers of per-path buffers and compute the number of elements
+    // all paths have credit for.
+    auto clean = true;
+    auto chunk_size = std::numeric_limits<size_t>::max();
+    auto batch_size = std::numeric_limits<int32_t>::max();
+    auto f = [&](typename map_type::value_type& x,
+                 typename state_map_type::value_type& y) {
+      auto& path = *x.second;
+      auto& cache = y.second.buf;
+      if (!cache.empty()) {
+        // Always force batches on closing paths.
+        path.emit_batches(self, cache, force_underfull || path.closing,
+                          *this);
+        if (!cache.empty() && !path.closing)
+          clean = false;
+      }
+      if (path.closing)
+        return;
+      chunk_size = std::min(chunk_size,
+                            static_cast<size_t>(std::max(path.open_credit,
+                                                         int32_t{0})));
+      batch_size = std::min(batch_size, path.desired_batch_size);
+    };
+    detail::zip_foreach(f, this->paths_.container(), state_map_.container());
+    if (!clean)
+      return false;
+    // Nothing left to do if all paths are closing.
+    if (chunk_size == std::numeric_limits<size_t>::max())
+      return true;
+    CAF_ASSERT(batch_size > 0);
+    auto& buf = this->buf_;
+    auto n = std::min(chunk_size, buf.size());
+    auto bs = static_cast<size_t>(batch_size);
+    if (!force_underfull)
+      n -= n % bs;
+    if (n == 0)
+      return true;
+    // Build each batch once.
+    std::vector<std::pair<int32_t, message>> batches;
+    batches.reserve((n + bs - 1) / bs);
+    auto first = buf.begin();
+    for (size_t i = 0; i < n; i += bs) {
+      auto m = std::min(bs, n - i);
+      auto j = first + static_cast<ptrdiff_t>(i);
+      batches.emplace_back(static_cast<int32_t>(m),
+                           this->make_batch(j,
+                                            j + static_cast<ptrdiff_t>(m)));
+    }
+    buf.erase(first, first + static_cast<ptrdiff_t>(n));
+    // Send the same messages on all paths.
+    for (auto& kvp : this->paths_) {
+      auto& path = *kvp.second;
+      if (!path.closing)
+        for (auto& batch : batches)
+          path.emit_batch(self, batch.first, batch.second);
+    }
+    return true;
+  }
+
   state_map_type state_map_;
   select_type select_;
+  bool shared_batches_;
 };
 
 } // namespace caf
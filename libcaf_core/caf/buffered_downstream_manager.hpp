@@ -18,18 +18,24 @@
 
 #pragma once
 
-#include <deque>
 #include <vector>
 #include <cstddef>
 #include <iterator>
 
 #include "caf/downstream_manager_base.hpp"
 #include "caf/logger.hpp"
+#include "caf/make_counted.hpp"
+#include "caf/message.hpp"
+
+#include "caf/detail/batch_pool.hpp"
+#include "caf/detail/ring_buffer.hpp"
 
 namespace caf {
 
 /// Mixin for streams with any number of downstreams. `Subtype` must provide a
 /// member function `buf()` returning a queue with `std::deque`-like interface.
+/// Stores elements in a ring buffer and creates batches from a pool of slabs
+/// that receivers return after processing a batch.
 template <class T>
 class buffered_downstream_manager : public downstream_manager_base {
 public:
@@ -39,13 +45,19 @@ public:
 
   using output_type = T;
 
-  using buffer_type = std::deque<output_type>;
+  using buffer_type = detail::ring_buffer<output_type>;
 
   using chunk_type = std::vector<output_type>;
 
+  using pool_type = detail::batch_pool<output_type>;
+
+  using iterator = typename buffer_type::iterator;
+
   // -- constructors, destructors, and assignment operators --------------------
 
-  explicit buffered_downstream_manager(stream_manager* parent) : super(parent) {
+  explicit buffered_downstream_manager(stream_manager* parent)
+      : super(parent),
+        pool_(make_counted<pool_type>()) {
     // nop
   }
 
@@ -105,8 +117,21 @@ public:
     return buf_;
   }
 
+  /// Returns the pool for creating batches.
+  pool_type& pool() {
+    return *pool_;
+  }
+
+  /// Creates the content of a batch by moving all elements in `[first, last)`
+  /// out of a buffer. Subtypes override this member function to change the
+  /// representation of batches on the wire.
+  virtual message make_batch(iterator first, iterator last) {
+    return pool_->make_batch(first, last);
+  }
+
 protected:
   buffer_type buf_;
+  detail::batch_pool_ptr<output_type> pool_;
 };
 
 } // namespace caf
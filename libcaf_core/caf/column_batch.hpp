@@ -0,0 +1,357 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+
+#include "caf/column_type.hpp"
+#include "caf/config.hpp"
+#include "caf/error.hpp"
+#include "caf/none.hpp"
+#include "caf/raise_error.hpp"
+#include "caf/sec.hpp"
+
+#include "caf/meta/load_callback.hpp"
+#include "caf/meta/type_name.hpp"
+
+#include "caf/detail/column_inspectors.hpp"
+#include "caf/detail/type_traits.hpp"
+
+namespace caf {
+
+/// A view to the elements of a single column.
+template <class T>
+class column_span {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = typename std::remove_const<T>::type;
+
+  using iterator = T*;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  column_span(T* data, size_t size) noexcept : data_(data), size_(size) {
+    // nop
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  T* data() const noexcept {
+    return data_;
+  }
+
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  T& operator[](size_t pos) const noexcept {
+    CAF_ASSERT(pos < size_);
+    return data_[pos];
+  }
+
+  iterator begin() const noexcept {
+    return data_;
+  }
+
+  iterator end() const noexcept {
+    return data_ + size_;
+  }
+
+private:
+  T* data_;
+  size_t size_;
+};
+
+/// Stores a sequence of `T` values with one contiguous array per field
+/// instead of one contiguous array of `T` values. All fields of `T` and its
+/// nested types must be integers or floating point numbers. The layout of the
+/// columns follows the `inspect` overload of `T`. Serializing a batch copies
+/// each column as a single block of bytes.
+///
+/// Using a `column_batch` for sending a stream over the network requires
+/// adding it to the actor system config via `add_message_type`.
+template <class T>
+class column_batch {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = T;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  column_batch() : rows_(0), little_endian_(host_little_endian()) {
+    if (!columnar())
+      CAF_RAISE_ERROR("type has no columnar layout");
+    auto& types = layout();
+    columns_.resize(types.size());
+    for (size_t i = 0; i < types.size(); ++i)
+      columns_[i].type = types[i];
+  }
+
+  template <class Iterator>
+  column_batch(Iterator first, Iterator last) : column_batch() {
+    append(first, last);
+  }
+
+  column_batch(column_batch&&) = default;
+
+  column_batch(const column_batch&) = default;
+
+  column_batch& operator=(column_batch&&) = default;
+
+  column_batch& operator=(const column_batch&) = default;
+
+  // -- static utility functions -----------------------------------------------
+
+  /// Returns whether `T` maps to columns.
+  static bool columnar() {
+    return get_layout().first;
+  }
+
+  /// Returns the types of all columns of `T`.
+  static const std::vector<column_type>& layout() {
+    return get_layout().second;
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of stored `T` values.
+  size_t rows() const noexcept {
+    return rows_;
+  }
+
+  /// Returns the number of columns.
+  size_t columns() const noexcept {
+    return columns_.size();
+  }
+
+  bool empty() const noexcept {
+    return rows_ == 0;
+  }
+
+  /// Returns the type of the column at position `i`.
+  column_type type(size_t i) const {
+    CAF_ASSERT(i < columns_.size());
+    return columns_[i].type;
+  }
+
+  /// Returns a view to the column at position `i`.
+  /// @pre `type(i) == column_type_of<U>::value`
+  template <class U>
+  column_span<U> column(size_t i) {
+    check_column<U>(i);
+    return {reinterpret_cast<U*>(columns_[i].bytes.data()), rows_};
+  }
+
+  /// Returns a view to the column at position `i`.
+  /// @pre `type(i) == column_type_of<U>::value`
+  template <class U>
+  column_span<const U> column(size_t i) const {
+    check_column<U>(i);
+    return {reinterpret_cast<const U*>(columns_[i].bytes.data()), rows_};
+  }
+
+  /// Returns the `T` value at position `i`.
+  T row(size_t i) const {
+    CAF_ASSERT(i < rows_);
+    T result;
+    detail::column_reader f{columns_, i};
+    f(result);
+    return result;
+  }
+
+  /// Converts all columns back to a sequence of `T` values.
+  std::vector<T> to_rows() const {
+    std::vector<T> result;
+    to_rows(result, std::is_default_constructible<T>{});
+    return result;
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Makes sure the batch stores up to `n` rows without allocating.
+  void reserve(size_t n) {
+    for (auto& col : columns_)
+      col.bytes.reserve(n * element_size(col.type));
+  }
+
+  /// Sets the number of rows to `n`. New rows are zero-initialized, i.e.,
+  /// callers usually fill them afterwards via `column`.
+  void resize(size_t n) {
+    for (auto& col : columns_)
+      col.bytes.resize(n * element_size(col.type));
+    rows_ = n;
+  }
+
+  /// Appends `x` as a new row.
+  void push_back(const T& x) {
+    detail::column_writer f{columns_};
+    // The writer only reads from `x`.
+    f(const_cast<T&>(x));
+    ++rows_;
+  }
+
+  /// Appends all values in `[first, last)`.
+  template <class Iterator>
+  void append(Iterator first, Iterator last) {
+    using category =
+      typename std::iterator_traits<Iterator>::iterator_category;
+    append(first, last, category{});
+  }
+
+  /// Removes all rows while keeping the allocated storage.
+  void clear() noexcept {
+    for (auto& col : columns_)
+      col.bytes.clear();
+    rows_ = 0;
+  }
+
+  // -- inspection -------------------------------------------------------------
+
+  template <class Inspector>
+  friend typename Inspector::result_type inspect(Inspector& f,
+                                                 column_batch& x) {
+    // Deserializing appends to `columns_` instead of overriding it.
+    auto before_load = [&x]() -> error {
+      x.columns_.clear();
+      return none;
+    };
+    auto after_load = [&x]() -> error {
+      return x.after_load();
+    };
+    return f(meta::type_name("column_batch"), meta::load_callback(before_load),
+             x.rows_, x.little_endian_, x.columns_,
+             meta::load_callback(after_load));
+  }
+
+  // -- comparison -------------------------------------------------------------
+
+  friend bool operator==(const column_batch& x, const column_batch& y) {
+    return x.rows_ == y.rows_ && x.columns_ == y.columns_;
+  }
+
+  friend bool operator!=(const column_batch& x, const column_batch& y) {
+    return !(x == y);
+  }
+
+private:
+  // -- utility functions ------------------------------------------------------
+
+  static const std::pair<bool, std::vector<column_type>>& get_layout() {
+    static std::pair<bool, std::vector<column_type>> result = [] {
+      std::vector<column_type> types;
+      auto valid = make_layout(types, std::is_default_constructible<T>{});
+      return std::make_pair(valid, std::move(types));
+    }();
+    return result;
+  }
+
+  static bool make_layout(std::vector<column_type>& types, std::true_type) {
+    detail::column_layout_inspector f{types};
+    T tmp;
+    f(tmp);
+    return f.valid();
+  }
+
+  static bool make_layout(std::vector<column_type>&, std::false_type) {
+    return false;
+  }
+
+  void to_rows(std::vector<T>& result, std::true_type) const {
+    result.reserve(rows_);
+    for (size_t i = 0; i < rows_; ++i)
+      result.emplace_back(row(i));
+  }
+
+  void to_rows(std::vector<T>&, std::false_type) const {
+    // nop, cannot construct a batch for T in the first place
+  }
+
+  static bool host_little_endian() noexcept {
+    uint16_t x = 1;
+    char first;
+    memcpy(&first, &x, 1);
+    return first == 1;
+  }
+
+  template <class U>
+  void check_column(size_t i) const {
+    static_assert(column_type_of<U>::supported,
+                  "U is not a valid column element type");
+    CAF_ASSERT(i < columns_.size());
+    if (columns_[i].type != column_type_of<U>::value)
+      CAF_RAISE_ERROR("column type mismatch");
+  }
+
+  template <class Iterator>
+  void append(Iterator first, Iterator last, std::forward_iterator_tag) {
+    reserve(rows_ + static_cast<size_t>(std::distance(first, last)));
+    append(first, last, std::input_iterator_tag{});
+  }
+
+  template <class Iterator>
+  void append(Iterator first, Iterator last, std::input_iterator_tag) {
+    for (; first != last; ++first)
+      push_back(*first);
+  }
+
+  // Checks the columns after deserializing a batch and converts the columns to
+  // the byte order of the host if necessary.
+  error after_load() {
+    auto& types = layout();
+    if (columns_.size() != types.size())
+      return sec::invalid_argument;
+    for (size_t i = 0; i < types.size(); ++i) {
+      auto& col = columns_[i];
+      if (col.type != types[i]
+          || col.bytes.size() != rows_ * element_size(col.type))
+        return sec::invalid_argument;
+    }
+    if (little_endian_ != host_little_endian()) {
+      for (auto& col : columns_) {
+        auto n = element_size(col.type);
+        if (n > 1)
+          for (auto i = col.bytes.begin(); i != col.bytes.end(); i += n)
+            std::reverse(i, i + n);
+      }
+      little_endian_ = !little_endian_;
+    }
+    return none;
+  }
+
+  // -- member variables -------------------------------------------------------
+
+  size_t rows_;
+  bool little_endian_;
+  std::vector<detail::column_data> columns_;
+};
+
+} // namespace caf
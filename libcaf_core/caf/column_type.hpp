@@ -0,0 +1,89 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace caf {
+
+/// Element types of the columns in a `column_batch`.
+enum class column_type : uint8_t {
+  int8,
+  int16,
+  int32,
+  int64,
+  uint8,
+  uint16,
+  uint32,
+  uint64,
+  float32,
+  float64
+};
+
+/// @relates column_type
+std::string to_string(column_type x);
+
+/// Returns the size of a single element in a column of type `x`.
+/// @relates column_type
+size_t element_size(column_type x);
+
+/// Returns whether `x` is a valid column type, i.e., whether `x` has one of
+/// the enumerated values.
+/// @relates column_type
+inline bool valid(column_type x) {
+  return static_cast<uint8_t>(x) <= static_cast<uint8_t>(column_type::float64);
+}
+
+/// Maps `T` to its column type. The member constant `supported` is `false` for
+/// all types that cannot be stored in a column.
+template <class T, class = void>
+struct column_type_of {
+  static constexpr bool supported = false;
+};
+
+template <class T>
+struct column_type_of<T, typename std::enable_if<
+                           std::is_integral<T>::value
+                           && !std::is_same<T, bool>::value
+                           && sizeof(T) <= 8>::type> {
+  static constexpr bool supported = true;
+
+  static constexpr column_type value = static_cast<column_type>(
+    (sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3)
+    + (std::is_signed<T>::value ? 0 : 4));
+};
+
+template <>
+struct column_type_of<float> {
+  static constexpr bool supported = true;
+
+  static constexpr column_type value = column_type::float32;
+};
+
+template <>
+struct column_type_of<double> {
+  static constexpr bool supported = true;
+
+  static constexpr column_type value = column_type::float64;
+};
+
+} // namespace caf
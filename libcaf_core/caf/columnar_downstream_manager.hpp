@@ -0,0 +1,55 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <iterator>
+
+#include "caf/broadcast_downstream_manager.hpp"
+#include "caf/column_batch.hpp"
+#include "caf/make_message.hpp"
+
+namespace caf {
+
+/// Broadcasts elements to all paths like `broadcast_downstream_manager`, but
+/// ships each batch as a `column_batch<T>` instead of a `std::vector<T>`.
+/// Sinks and stages receive the batch via `process_columns` on their driver.
+template <class T, class Filter = unit_t, class Select = detail::select_all>
+class columnar_downstream_manager
+  : public broadcast_downstream_manager<T, Filter, Select> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = broadcast_downstream_manager<T, Filter, Select>;
+
+  using typename super::iterator;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  columnar_downstream_manager(stream_manager* parent) : super(parent) {
+    // nop
+  }
+
+  // -- overridden member functions --------------------------------------------
+
+  message make_batch(iterator first, iterator last) override {
+    return make_message(column_batch<T>{first, last});
+  }
+};
+
+} // namespace caf
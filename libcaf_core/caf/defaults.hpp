@@ -78,6 +78,19 @@ extern const size_t max_consecutive_reads;
 extern const size_t heartbeat_interval;
 extern const size_t cached_udp_buffers;
 extern const size_t max_pending_msgs;
+extern const size_t flush_threshold;
+extern const timespan max_flush_delay;
+extern const size_t multiplexer_threads;
+extern const size_t datagram_batch_size;
+extern const size_t buffer_pool_size;
+extern const size_t connections_per_peer;
+extern const size_t fragment_size;
+extern const size_t high_watermark;
+extern const size_t low_watermark;
+extern const atom_value backpressure;
+extern const size_t reliable_udp_window;
+extern const atom_value compression;
+extern const size_t compression_threshold;
 
 } // namespace middleman
 
@@ -0,0 +1,149 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <iterator>
+
+#include "caf/intrusive_ptr.hpp"
+#include "caf/message.hpp"
+#include "caf/make_counted.hpp"
+#include "caf/ref_counted.hpp"
+
+#include "caf/detail/tuple_vals.hpp"
+
+namespace caf {
+namespace detail {
+
+template <class T>
+class batch_pool;
+
+/// Message content for a batch that returns its storage to a `batch_pool`
+/// once the last message referencing it goes away.
+template <class T>
+class pooled_batch : public tuple_vals<std::vector<T>> {
+public:
+  using super = tuple_vals<std::vector<T>>;
+
+  pooled_batch(intrusive_ptr<batch_pool<T>> pool, std::vector<T>&& xs)
+      : super(std::move(xs)),
+        pool_(std::move(pool)) {
+    // nop
+  }
+
+  ~pooled_batch() override {
+    pool_->release(std::get<0>(this->data()));
+  }
+
+private:
+  intrusive_ptr<batch_pool<T>> pool_;
+};
+
+/// Recycles the storage of stream batches. Each batch is a slab of memory
+/// that travels to the receiver inside a message and comes back to the pool
+/// after the receiver processed the batch and dropped the message. Keeps at
+/// most `max_slabs` idle slabs.
+/// @threadsafe
+template <class T>
+class batch_pool : public ref_counted {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using slab_type = std::vector<T>;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Default for the maximum number of idle slabs.
+  static constexpr size_t default_max_slabs = 32;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit batch_pool(size_t max_slabs = default_max_slabs)
+      : max_slabs_(max_slabs),
+        reused_(0) {
+    // nop
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of idle slabs.
+  size_t idle() const {
+    std::unique_lock<std::mutex> guard{mtx_};
+    return slabs_.size();
+  }
+
+  /// Returns how many batches reused a slab.
+  size_t reused() const {
+    std::unique_lock<std::mutex> guard{mtx_};
+    return reused_;
+  }
+
+  // -- slab management --------------------------------------------------------
+
+  /// Returns an empty slab with a capacity of at least `n` elements.
+  slab_type acquire(size_t n) {
+    slab_type result;
+    {
+      std::unique_lock<std::mutex> guard{mtx_};
+      if (!slabs_.empty()) {
+        result.swap(slabs_.back());
+        slabs_.pop_back();
+        ++reused_;
+      }
+    }
+    result.reserve(n);
+    return result;
+  }
+
+  /// Destroys all elements in `xs` and stores its memory for later reuse.
+  void release(slab_type& xs) {
+    xs.clear();
+    if (xs.capacity() == 0)
+      return;
+    std::unique_lock<std::mutex> guard{mtx_};
+    if (slabs_.size() < max_slabs_)
+      slabs_.emplace_back(std::move(xs));
+  }
+
+  /// Moves `[first, last)` into a slab and wraps it into a message.
+  template <class Iterator>
+  message make_batch(Iterator first, Iterator last) {
+    auto xs = acquire(static_cast<size_t>(std::distance(first, last)));
+    xs.insert(xs.end(), std::make_move_iterator(first),
+              std::make_move_iterator(last));
+    intrusive_ptr<batch_pool> self{this};
+    auto ptr = make_counted<pooled_batch<T>>(std::move(self), std::move(xs));
+    return message{message_data::cow_ptr{std::move(ptr)}};
+  }
+
+private:
+  mutable std::mutex mtx_;
+  size_t max_slabs_;
+  size_t reused_;
+  std::vector<slab_type> slabs_;
+};
+
+/// @relates batch_pool
+template <class T>
+using batch_pool_ptr = intrusive_ptr<batch_pool<T>>;
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,210 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "caf/column_type.hpp"
+#include "caf/config.hpp"
+
+#include "caf/meta/annotation.hpp"
+#include "caf/meta/type_name.hpp"
+
+#include "caf/detail/type_traits.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Stores the elements of a single column as raw bytes.
+struct column_data {
+  column_type type;
+  std::vector<char> bytes;
+};
+
+/// @relates column_data
+inline bool operator==(const column_data& x, const column_data& y) {
+  return x.type == y.type && x.bytes == y.bytes;
+}
+
+/// @relates column_data
+template <class Inspector>
+typename Inspector::result_type inspect(Inspector& f, column_data& x) {
+  return f(meta::type_name("column"), x.type, x.bytes);
+}
+
+/// Visits all fields of a type in the order of its `inspect` overload for
+/// mapping them to columns. Skips annotations and recurses into nested
+/// inspectable types. Any other field disqualifies the type from a columnar
+/// layout. `Derived` handles arithmetic fields by providing `field(x)`.
+template <class Derived>
+class column_inspector {
+public:
+  // -- member types required by Inspector concept -----------------------------
+
+  using result_type = void;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  column_inspector() : valid_(true) {
+    // nop
+  }
+
+  // -- operator() -------------------------------------------------------------
+
+  template <class... Ts>
+  void operator()(Ts&&... xs) {
+    traverse(xs...);
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns whether all visited fields mapped to a column.
+  bool valid() const noexcept {
+    return valid_;
+  }
+
+private:
+  void traverse() {
+    // end of recursion
+  }
+
+  template <class T, class... Ts>
+  void traverse(T& x, Ts&... xs) {
+    static constexpr int category =
+      meta::is_annotation<T>::value
+      ? 0
+      : (std::is_const<T>::value
+         ? 3
+         : (column_type_of<T>::supported
+            ? 1
+            : (is_inspectable<Derived, T>::value ? 2 : 3)));
+    visit(x, int_token<category>{});
+    traverse(xs...);
+  }
+
+  template <class T>
+  void visit(T&, int_token<0>) {
+    // skip annotations
+  }
+
+  template <class T>
+  void visit(T& x, int_token<1>) {
+    dref().field(x);
+  }
+
+  template <class T>
+  void visit(T& x, int_token<2>) {
+    inspect(dref(), x);
+  }
+
+  template <class T>
+  void visit(T&, int_token<3>) {
+    valid_ = false;
+  }
+
+  Derived& dref() {
+    return static_cast<Derived&>(*this);
+  }
+
+  bool valid_;
+};
+
+/// Collects the column types of all fields.
+class column_layout_inspector
+  : public column_inspector<column_layout_inspector> {
+public:
+  static constexpr bool reads_state = false;
+
+  static constexpr bool writes_state = false;
+
+  explicit column_layout_inspector(std::vector<column_type>& types)
+      : types_(types) {
+    // nop
+  }
+
+  template <class T>
+  void field(T&) {
+    column_type x = column_type_of<T>::value;
+    types_.push_back(x);
+  }
+
+private:
+  std::vector<column_type>& types_;
+};
+
+/// Appends all fields as a new row to a set of columns.
+class column_writer : public column_inspector<column_writer> {
+public:
+  static constexpr bool reads_state = true;
+
+  static constexpr bool writes_state = false;
+
+  explicit column_writer(std::vector<column_data>& columns)
+      : columns_(columns),
+        pos_(0) {
+    // nop
+  }
+
+  template <class T>
+  void field(T& x) {
+    CAF_ASSERT(pos_ < columns_.size());
+    auto& buf = columns_[pos_++].bytes;
+    auto offset = buf.size();
+    buf.resize(offset + sizeof(T));
+    memcpy(buf.data() + offset, &x, sizeof(T));
+  }
+
+private:
+  std::vector<column_data>& columns_;
+  size_t pos_;
+};
+
+/// Assigns all fields from a single row of a set of columns.
+class column_reader : public column_inspector<column_reader> {
+public:
+  static constexpr bool reads_state = false;
+
+  static constexpr bool writes_state = true;
+
+  column_reader(const std::vector<column_data>& columns, size_t row)
+      : columns_(columns),
+        row_(row),
+        pos_(0) {
+    // nop
+  }
+
+  template <class T>
+  void field(T& x) {
+    CAF_ASSERT(pos_ < columns_.size());
+    auto& buf = columns_[pos_++].bytes;
+    CAF_ASSERT((row_ + 1) * sizeof(T) <= buf.size());
+    memcpy(&x, buf.data() + row_ * sizeof(T), sizeof(T));
+  }
+
+private:
+  const std::vector<column_data>& columns_;
+  size_t row_;
+  size_t pos_;
+};
+
+} // namespace detail
+} // namespace caf
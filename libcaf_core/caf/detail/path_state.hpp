@@ -19,10 +19,11 @@
 #pragma once
 
 #include <new>
-#include <vector>
 
 #include "caf/unit.hpp"
 
+#include "caf/detail/ring_buffer.hpp"
+
 namespace caf {
 namespace detail {
 
@@ -30,13 +31,13 @@ namespace detail {
 template <class Filter, class T>
 struct path_state {
   Filter filter;
-  std::vector<T> buf;
+  ring_buffer<T> buf;
 };
 
 /// Compress path_state if `Filter` is `unit`.
 template <class T>
 struct path_state<unit_t, T> {
-  using buffer_type = std::vector<T>;
+  using buffer_type = ring_buffer<T>;
 
   union {
     unit_t filter;
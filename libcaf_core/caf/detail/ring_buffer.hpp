@@ -0,0 +1,459 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <new>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <initializer_list>
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace detail {
+
+/// A growable queue on top of a single contiguous array. Elements wrap around
+/// at the end of the array, i.e., removing elements from the front never
+/// moves any element and appending only allocates once the array is full.
+/// Provides the subset of the `std::deque` interface used by downstream
+/// managers: appending at the back, erasing at the front or back, and
+/// random access.
+template <class T>
+class ring_buffer {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = T;
+
+  using size_type = size_t;
+
+  using difference_type = ptrdiff_t;
+
+  using reference = T&;
+
+  using const_reference = const T&;
+
+  using pointer = T*;
+
+  using const_pointer = const T*;
+
+  /// Random access iterator over a ring buffer.
+  template <bool IsConst>
+  class iterator_impl {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+
+    using value_type = T;
+
+    using difference_type = ptrdiff_t;
+
+    using pointer = typename std::conditional<IsConst, const T*, T*>::type;
+
+    using reference = typename std::conditional<IsConst, const T&, T&>::type;
+
+    using container_pointer =
+      typename std::conditional<IsConst, const ring_buffer*,
+                                ring_buffer*>::type;
+
+    iterator_impl() noexcept : buf_(nullptr), pos_(0) {
+      // nop
+    }
+
+    iterator_impl(container_pointer buf, size_t pos) noexcept
+        : buf_(buf),
+          pos_(pos) {
+      // nop
+    }
+
+    // Allows implicit conversion from iterator to const_iterator.
+    template <bool B, class E = typename std::enable_if<IsConst && !B>::type>
+    iterator_impl(const iterator_impl<B>& other) noexcept
+        : buf_(other.container()),
+          pos_(other.position()) {
+      // nop
+    }
+
+    reference operator*() const noexcept {
+      return (*buf_)[pos_];
+    }
+
+    pointer operator->() const noexcept {
+      return &(*buf_)[pos_];
+    }
+
+    reference operator[](difference_type n) const noexcept {
+      return (*buf_)[static_cast<size_t>(static_cast<difference_type>(pos_)
+                                         + n)];
+    }
+
+    iterator_impl& operator++() noexcept {
+      ++pos_;
+      return *this;
+    }
+
+    iterator_impl operator++(int) noexcept {
+      auto result = *this;
+      ++pos_;
+      return result;
+    }
+
+    iterator_impl& operator--() noexcept {
+      --pos_;
+      return *this;
+    }
+
+    iterator_impl operator--(int) noexcept {
+      auto result = *this;
+      --pos_;
+      return result;
+    }
+
+    iterator_impl& operator+=(difference_type n) noexcept {
+      pos_ = static_cast<size_t>(static_cast<difference_type>(pos_) + n);
+      return *this;
+    }
+
+    iterator_impl& operator-=(difference_type n) noexcept {
+      return *this += -n;
+    }
+
+    friend iterator_impl operator+(iterator_impl x, difference_type n) {
+      return x += n;
+    }
+
+    friend iterator_impl operator+(difference_type n, iterator_impl x) {
+      return x += n;
+    }
+
+    friend iterator_impl operator-(iterator_impl x, difference_type n) {
+      return x -= n;
+    }
+
+    friend difference_type operator-(const iterator_impl& x,
+                                     const iterator_impl& y) {
+      return static_cast<difference_type>(x.pos_)
+             - static_cast<difference_type>(y.pos_);
+    }
+
+    friend bool operator==(const iterator_impl& x, const iterator_impl& y) {
+      return x.pos_ == y.pos_;
+    }
+
+    friend bool operator!=(const iterator_impl& x, const iterator_impl& y) {
+      return x.pos_ != y.pos_;
+    }
+
+    friend bool operator<(const iterator_impl& x, const iterator_impl& y) {
+      return x.pos_ < y.pos_;
+    }
+
+    friend bool operator<=(const iterator_impl& x, const iterator_impl& y) {
+      return x.pos_ <= y.pos_;
+    }
+
+    friend bool operator>(const iterator_impl& x, const iterator_impl& y) {
+      return x.pos_ > y.pos_;
+    }
+
+    friend bool operator>=(const iterator_impl& x, const iterator_impl& y) {
+      return x.pos_ >= y.pos_;
+    }
+
+    container_pointer container() const noexcept {
+      return buf_;
+    }
+
+    size_t position() const noexcept {
+      return pos_;
+    }
+
+  private:
+    container_pointer buf_;
+    size_t pos_;
+  };
+
+  using iterator = iterator_impl<false>;
+
+  using const_iterator = iterator_impl<true>;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Capacity of the first allocation.
+  static constexpr size_t min_capacity = 16;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  ring_buffer() noexcept : data_(nullptr), capacity_(0), head_(0), size_(0) {
+    // nop
+  }
+
+  ring_buffer(const ring_buffer& other) : ring_buffer() {
+    reserve(other.size_);
+    for (auto& x : other)
+      emplace_back(x);
+  }
+
+  ring_buffer(ring_buffer&& other) noexcept : ring_buffer() {
+    swap(other);
+  }
+
+  template <class InputIterator>
+  ring_buffer(InputIterator first, InputIterator last) : ring_buffer() {
+    insert(end(), first, last);
+  }
+
+  ring_buffer(std::initializer_list<T> xs) : ring_buffer() {
+    insert(end(), xs.begin(), xs.end());
+  }
+
+  ~ring_buffer() {
+    clear();
+    if (data_ != nullptr)
+      alloc_.deallocate(data_, capacity_);
+  }
+
+  ring_buffer& operator=(const ring_buffer& other) {
+    if (this != &other) {
+      ring_buffer tmp{other};
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  ring_buffer& operator=(ring_buffer&& other) noexcept {
+    ring_buffer tmp{std::move(other)};
+    swap(tmp);
+    return *this;
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  // -- element access ---------------------------------------------------------
+
+  reference operator[](size_t pos) noexcept {
+    CAF_ASSERT(pos < size_);
+    return data_[index(pos)];
+  }
+
+  const_reference operator[](size_t pos) const noexcept {
+    CAF_ASSERT(pos < size_);
+    return data_[index(pos)];
+  }
+
+  reference front() noexcept {
+    return (*this)[0];
+  }
+
+  const_reference front() const noexcept {
+    return (*this)[0];
+  }
+
+  reference back() noexcept {
+    return (*this)[size_ - 1];
+  }
+
+  const_reference back() const noexcept {
+    return (*this)[size_ - 1];
+  }
+
+  // -- iterator access --------------------------------------------------------
+
+  iterator begin() noexcept {
+    return {this, 0};
+  }
+
+  const_iterator begin() const noexcept {
+    return {this, 0};
+  }
+
+  const_iterator cbegin() const noexcept {
+    return {this, 0};
+  }
+
+  iterator end() noexcept {
+    return {this, size_};
+  }
+
+  const_iterator end() const noexcept {
+    return {this, size_};
+  }
+
+  const_iterator cend() const noexcept {
+    return {this, size_};
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Makes sure the buffer stores up to `n` elements without allocating.
+  void reserve(size_t n) {
+    if (n <= capacity_)
+      return;
+    auto new_capacity = std::max(capacity_, min_capacity);
+    while (new_capacity < n)
+      new_capacity *= 2;
+    auto new_data = alloc_.allocate(new_capacity);
+    for (size_t i = 0; i < size_; ++i) {
+      auto& x = data_[index(i)];
+      new (new_data + i) T(std::move(x));
+      x.~T();
+    }
+    if (data_ != nullptr)
+      alloc_.deallocate(data_, capacity_);
+    data_ = new_data;
+    capacity_ = new_capacity;
+    head_ = 0;
+  }
+
+  template <class... Ts>
+  void emplace_back(Ts&&... xs) {
+    if (size_ == capacity_) {
+      // The arguments may refer to elements of this buffer.
+      T tmp(std::forward<Ts>(xs)...);
+      reserve(capacity_ + 1);
+      new (data_ + index(size_)) T(std::move(tmp));
+    } else {
+      new (data_ + index(size_)) T(std::forward<Ts>(xs)...);
+    }
+    ++size_;
+  }
+
+  void push_back(const T& x) {
+    emplace_back(x);
+  }
+
+  void push_back(T&& x) {
+    emplace_back(std::move(x));
+  }
+
+  /// Appends `[first, last)`.
+  /// @pre `pos == end()`
+  template <class InputIterator>
+  iterator insert(const_iterator pos, InputIterator first,
+                  InputIterator last) {
+    CAF_ASSERT(pos == cend());
+    CAF_IGNORE_UNUSED(pos);
+    auto offset = size_;
+    using category =
+      typename std::iterator_traits<InputIterator>::iterator_category;
+    reserve_for(first, last, category{});
+    for (; first != last; ++first)
+      emplace_back(*first);
+    return {this, offset};
+  }
+
+  /// Erases `[first, last)`.
+  /// @pre `first == begin() || last == end()`
+  iterator erase(const_iterator first, const_iterator last) {
+    CAF_ASSERT(first <= last);
+    auto n = static_cast<size_t>(last - first);
+    if (first == cbegin()) {
+      for (size_t i = 0; i < n; ++i)
+        data_[index(i)].~T();
+      head_ = size_ == n ? 0 : index(n);
+      size_ -= n;
+      return begin();
+    }
+    CAF_ASSERT(last == cend());
+    for (auto i = first.position(); i < size_; ++i)
+      data_[index(i)].~T();
+    size_ -= n;
+    return end();
+  }
+
+  void pop_front() {
+    CAF_ASSERT(!empty());
+    erase(cbegin(), cbegin() + 1);
+  }
+
+  void pop_back() {
+    CAF_ASSERT(!empty());
+    erase(cend() - 1, cend());
+  }
+
+  /// Destroys all elements while keeping the allocated storage.
+  void clear() noexcept {
+    for (size_t i = 0; i < size_; ++i)
+      data_[index(i)].~T();
+    head_ = 0;
+    size_ = 0;
+  }
+
+  void swap(ring_buffer& other) noexcept {
+    using std::swap;
+    swap(data_, other.data_);
+    swap(capacity_, other.capacity_);
+    swap(head_, other.head_);
+    swap(size_, other.size_);
+  }
+
+private:
+  // Maps a logical position to an index into `data_`. The capacity is always
+  // a power of two.
+  size_t index(size_t pos) const noexcept {
+    return (head_ + pos) & (capacity_ - 1);
+  }
+
+  template <class Iterator>
+  void reserve_for(Iterator first, Iterator last,
+                   std::forward_iterator_tag) {
+    reserve(size_ + static_cast<size_t>(std::distance(first, last)));
+  }
+
+  template <class Iterator>
+  void reserve_for(Iterator, Iterator, std::input_iterator_tag) {
+    // nop
+  }
+
+  std::allocator<T> alloc_;
+  T* data_;
+  size_t capacity_;
+  size_t head_;
+  size_t size_;
+};
+
+/// @relates ring_buffer
+template <class T>
+bool operator==(const ring_buffer<T>& xs, const ring_buffer<T>& ys) {
+  return xs.size() == ys.size() && std::equal(xs.begin(), xs.end(), ys.begin());
+}
+
+/// @relates ring_buffer
+template <class T>
+bool operator!=(const ring_buffer<T>& xs, const ring_buffer<T>& ys) {
+  return !(xs == ys);
+}
+
+} // namespace detail
+} // namespace caf
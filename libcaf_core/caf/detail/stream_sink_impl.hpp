@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "caf/column_batch.hpp"
 #include "caf/config.hpp"
 #include "caf/logger.hpp"
 #include "caf/make_counted.hpp"
@@ -57,6 +58,11 @@ public:
       driver_.process(x.xs.get_mutable_as<vec_type>(0));
       return;
     }
+    using columns_type = column_batch<input_type>;
+    if (x.xs.match_elements<columns_type>()) {
+      driver_.process_columns(x.xs.get_mutable_as<columns_type>(0));
+      return;
+    }
     CAF_LOG_ERROR("received unexpected batch type (dropped)");
   }
 
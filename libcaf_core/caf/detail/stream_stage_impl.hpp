@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "caf/column_batch.hpp"
 #include "caf/downstream.hpp"
 #include "caf/logger.hpp"
 #include "caf/make_counted.hpp"
@@ -67,6 +68,12 @@ public:
       driver_.process(ds, x.xs.get_mutable_as<vec_type>(0));
       return;
     }
+    using columns_type = column_batch<input_type>;
+    if (x.xs.match_elements<columns_type>()) {
+      downstream<output_type> ds{this->out_.buf()};
+      driver_.process_columns(ds, x.xs.get_mutable_as<columns_type>(0));
+      return;
+    }
     CAF_LOG_ERROR("received unexpected batch type (dropped)");
   }
 
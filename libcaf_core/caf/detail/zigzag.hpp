@@ -0,0 +1,46 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <type_traits>
+
+namespace caf {
+namespace detail {
+
+/// Maps a signed integer to an unsigned integer such that values with small
+/// absolute value get small encodings, i.e., 0 -> 0, -1 -> 1, 1 -> 2, etc.
+template <class T>
+typename std::make_unsigned<T>::type zigzag_encode(T x) {
+  static_assert(std::is_signed<T>::value, "T must be a signed type");
+  using unsigned_type = typename std::make_unsigned<T>::type;
+  auto y = static_cast<unsigned_type>(static_cast<unsigned_type>(x) << 1);
+  return x < 0 ? static_cast<unsigned_type>(~y) : y;
+}
+
+/// Reverts `zigzag_encode`.
+template <class T>
+typename std::make_signed<T>::type zigzag_decode(T x) {
+  static_assert(std::is_unsigned<T>::value, "T must be an unsigned type");
+  using signed_type = typename std::make_signed<T>::type;
+  auto y = static_cast<T>(x >> 1);
+  return static_cast<signed_type>((x & 1) != 0 ? static_cast<T>(~y) : y);
+}
+
+} // namespace detail
+} // namespace caf
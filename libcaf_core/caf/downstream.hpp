@@ -18,11 +18,10 @@
 
 #pragma once
 
-#include <deque>
-#include <vector>
-
 #include "caf/make_message.hpp"
 
+#include "caf/detail/ring_buffer.hpp"
+
 namespace caf {
 
 /// Grants access to an output stream buffer.
@@ -32,7 +31,7 @@ public:
   // -- member types -----------------------------------------------------------
 
   /// A queue of items for temporary storage before moving them into chunks.
-  using queue_type = std::deque<T>;
+  using queue_type = detail::ring_buffer<T>;
 
   // -- constructors, destructors, and assignment operators --------------------
 
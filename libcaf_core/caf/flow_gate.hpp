@@ -0,0 +1,83 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "caf/actor_control_block.hpp"
+#include "caf/fwd.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/ref_counted.hpp"
+
+namespace caf {
+
+/// Signals local writers whether a shared resource, e.g., the send buffer of
+/// a network connection, currently accepts more data. Scheduled actors can
+/// park at a closed gate and get rescheduled once the gate opens again.
+/// @threadsafe
+class flow_gate : public ref_counted {
+public:
+  /// Configures how writers react to a closed gate.
+  enum class mode {
+    /// Silently discards new messages.
+    drop,
+    /// Discards new messages and responds to requests with an error.
+    error,
+    /// Suspends senders until the gate opens again.
+    pause
+  };
+
+  explicit flow_gate(mode policy = mode::pause);
+
+  ~flow_gate() override;
+
+  /// Returns how writers react to a closed gate.
+  inline mode policy() const {
+    return policy_;
+  }
+
+  /// Returns whether writers should hold back new data.
+  inline bool closed() const {
+    return closed_.load(std::memory_order_acquire);
+  }
+
+  /// Signals writers to hold back new data.
+  void close();
+
+  /// Signals writers to resume and reschedules all parked actors.
+  void open();
+
+  /// Stores `self` for rescheduling it once the gate opens. Returns `false`
+  /// without storing `self` if the gate is already open.
+  bool park(scheduled_actor* self);
+
+  /// Returns the number of currently parked actors.
+  size_t parked() const;
+
+private:
+  mode policy_;
+  std::atomic<bool> closed_;
+  mutable std::mutex mtx_;
+  std::vector<strong_actor_ptr> parked_;
+};
+
+} // namespace caf
@@ -20,17 +20,22 @@
 
 #include "caf/actor.hpp"
 #include "caf/actor_proxy.hpp"
+#include "caf/flow_gate.hpp"
 
 #include "caf/detail/shared_spinlock.hpp"
 
 namespace caf {
 
-/// Implements a simple proxy forwarding all operations to a manager.
+/// Implements a simple proxy forwarding all operations to a manager. An
+/// optional flow gate signals congestion on the path to the remote actor, in
+/// which case the proxy applies the backpressure policy of the gate to new
+/// messages.
 class forwarding_actor_proxy : public actor_proxy {
 public:
   using forwarding_stack = std::vector<strong_actor_ptr>;
 
-  forwarding_actor_proxy(actor_config& cfg, actor dest);
+  forwarding_actor_proxy(actor_config& cfg, actor dest,
+                         flow_gate_ptr gate = nullptr);
 
   ~forwarding_actor_proxy() override;
 
@@ -46,8 +51,13 @@ private:
   void forward_msg(strong_actor_ptr sender, message_id mid, message msg,
                    const forwarding_stack* fwd = nullptr);
 
+  /// Applies the policy of the closed gate to `x` and returns whether the
+  /// proxy forwards `x` anyways.
+  bool apply_backpressure(mailbox_element& x);
+
   mutable detail::shared_spinlock broker_mtx_;
   actor broker_;
+  flow_gate_ptr gate_;
 };
 
 } // namespace caf
@@ -99,6 +99,7 @@ class duration;
 class error;
 class event_based_actor;
 class execution_unit;
+class flow_gate;
 class forwarding_actor_proxy;
 class group;
 class group_module;
@@ -200,6 +201,7 @@ class middleman;
 
 namespace basp {
 
+class codec;
 struct header;
 
 } // namespace basp
@@ -259,6 +261,7 @@ using weak_actor_ptr = weak_intrusive_ptr<actor_control_block>;
 
 // -- intrusive pointer aliases ------------------------------------------------
 
+using flow_gate_ptr = intrusive_ptr<flow_gate>;
 using strong_actor_ptr = intrusive_ptr<actor_control_block>;
 using stream_manager_ptr = intrusive_ptr<stream_manager>;
 
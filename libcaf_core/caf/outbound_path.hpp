@@ -74,35 +74,52 @@ public:
   /// `xs_size` and increments `next_batch_id` by 1.
   void emit_batch(local_actor* self, int32_t xs_size, message xs);
 
-  template <class Iterator>
+  /// Creates batches by moving elements into a new `std::vector`.
+  struct default_batch_factory {
+    template <class Iterator>
+    message make_batch(Iterator first, Iterator last) {
+      using type = detail::decay_t<decltype(*first)>;
+      std::vector<type> tmp{std::make_move_iterator(first),
+                            std::make_move_iterator(last)};
+      return make_message(std::move(tmp));
+    }
+  };
+
+  /// Ships batches from `[i, e)`, calling `f.make_batch(first, last)` to
+  /// create the content of each batch.
+  template <class Iterator, class BatchFactory>
   Iterator emit_batches_impl(local_actor* self, Iterator i, Iterator e,
-                             bool force_underfull) {
+                             bool force_underfull, BatchFactory& f) {
     CAF_LOG_TRACE(CAF_ARG(force_underfull));
     CAF_ASSERT(desired_batch_size > 0);
-    using type = detail::decay_t<decltype(*i)>;
     // Ship full batches.
     while (std::distance(i, e) >= desired_batch_size) {
-      std::vector<type> tmp{std::make_move_iterator(i),
-                            std::make_move_iterator(i + desired_batch_size)};
-      emit_batch(self, desired_batch_size, make_message(std::move(tmp)));
+      emit_batch(self, desired_batch_size,
+                 f.make_batch(i, i + desired_batch_size));
       i += desired_batch_size;
     }
     // Ship underful batch only if `force_underful` is set.
     if (i != e && force_underfull) {
-      std::vector<type> tmp{std::make_move_iterator(i),
-                            std::make_move_iterator(e)};
-      auto tmp_size = static_cast<int32_t>(tmp.size());
-      emit_batch(self, tmp_size, make_message(std::move(tmp)));
+      auto tmp_size = static_cast<int32_t>(std::distance(i, e));
+      emit_batch(self, tmp_size, f.make_batch(i, e));
       return e;
     }
     return i;
   }
 
+  template <class Iterator>
+  Iterator emit_batches_impl(local_actor* self, Iterator i, Iterator e,
+                             bool force_underfull) {
+    default_batch_factory f;
+    return emit_batches_impl(self, i, e, force_underfull, f);
+  }
+
   /// Calls `emit_batch` for each chunk in the cache, whereas each chunk is of
-  /// size `desired_batch_size`. Does nothing for pending paths.
-  template <class T>
-  void emit_batches(local_actor* self, std::vector<T>& cache,
-                    bool force_underfull) {
+  /// size `desired_batch_size`. Does nothing for pending paths. The cache is
+  /// either a `std::vector` or a `detail::ring_buffer`.
+  template <class Cache, class BatchFactory>
+  void emit_batches(local_actor* self, Cache& cache, bool force_underfull,
+                    BatchFactory& f) {
     CAF_LOG_TRACE(CAF_ARG(slots) << CAF_ARG(open_credit) << CAF_ARG(cache)
                   << CAF_ARG(force_underfull));
     if (pending())
@@ -114,7 +131,7 @@ public:
                                  static_cast<int32_t>(cache.size()));
     if (first == last)
       return;
-    auto i = emit_batches_impl(self, first, last, force_underfull);
+    auto i = emit_batches_impl(self, first, last, force_underfull, f);
     if (i == cache.end()) {
       cache.clear();
     } else if (i != first) {
@@ -122,6 +139,12 @@ public:
     }
   }
 
+  template <class Cache>
+  void emit_batches(local_actor* self, Cache& cache, bool force_underfull) {
+    default_batch_factory f;
+    emit_batches(self, cache, force_underfull, f);
+  }
+
   /// Sends a `downstream_msg::close` on this path.
   void emit_regular_shutdown(local_actor* self);
 
@@ -24,6 +24,7 @@
 #include <exception>
 #endif // CAF_NO_EXCEPTIONS
 
+#include <atomic>
 #include <forward_list>
 #include <map>
 #include <type_traits>
@@ -306,6 +307,12 @@ public:
   ///          blocking API calls such as {@link receive()}.
   void quit(error x = error{});
 
+  /// Suspends this actor after the currently running message handler until
+  /// `gate` opens. Has no effect if `gate` opens before the actor suspends.
+  /// Incoming messages remain in the mailbox while the actor is suspended.
+  /// @threadsafe
+  void pause_until(flow_gate_ptr gate);
+
   // -- properties -------------------------------------------------------------
 
   /// Returns the queue for storing incoming messages.
@@ -642,6 +649,14 @@ public:
 
   /// @cond PRIVATE
 
+  // -- scheduling -------------------------------------------------------------
+
+  /// Adds a reference count to this actor and schedules it for execution.
+  void schedule(execution_unit* eu);
+
+  /// Reschedules this actor after the gate from `pause_until` opened.
+  void unpause();
+
   // -- timeout management -----------------------------------------------------
 
   /// Requests a new timeout and returns its ID.
@@ -932,6 +947,13 @@ protected:
   /// Pointer to a private thread object associated with a detached actor.
   detail::private_thread* private_thread_;
 
+  /// Stores the argument of the last `pause_until` call until `resume` picks
+  /// it up. Owns one reference count if not `nullptr`.
+  std::atomic<flow_gate*> pause_gate_;
+
+  /// Synchronizes suspending this actor in `resume` with `unpause`.
+  std::atomic<int> pause_state_;
+
 # ifndef CAF_NO_EXCEPTIONS
   /// Customization point for setting a default exception callback.
   exception_handler exception_handler_;
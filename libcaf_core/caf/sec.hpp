@@ -114,6 +114,8 @@ enum class sec : uint8_t {
   bad_function_call = 40,
   /// Feature is disabled in the actor system config.
   feature_disabled,
+  /// Rejected a message to a remote actor due to a congested connection.
+  remote_node_congested,
 };
 
 /// @relates sec
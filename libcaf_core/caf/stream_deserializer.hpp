@@ -34,6 +34,7 @@
 
 #include "caf/detail/ieee_754.hpp"
 #include "caf/detail/network_order.hpp"
+#include "caf/detail/zigzag.hpp"
 
 namespace caf {
 
@@ -75,8 +76,19 @@ public:
       streambuf_(std::forward<S>(sb)) {
   }
 
+  /// Enables or disables variable-length decoding for 16, 32 and 64-bit
+  /// integers. Must match the setting of the serializer.
+  void varint_encoding(bool x) {
+    varint_encoding_ = x;
+  }
+
+  /// Returns whether this deserializer uses variable-length integer encoding.
+  bool varint_encoding() const {
+    return varint_encoding_;
+  }
+
   error begin_object(uint16_t& typenr, std::string& name) override {
-    return error::eval([&] { return apply_int(typenr); },
+    return error::eval([&] { return apply_unsigned(typenr); },
                        [&] { return typenr == 0 ? apply(name) : error{}; });
   }
 
@@ -112,10 +124,14 @@ protected:
   template <class T>
   error varbyte_decode(T& x) {
     static_assert(std::is_unsigned<T>::value, "T must be an unsigned type");
+    // Reject sequences that exceed the maximum encoded size of T.
+    constexpr auto max_bytes = (sizeof(T) * 8 + 6) / 7;
     auto n = 0;
     x = 0;
     uint8_t low7;
     do {
+      if (static_cast<size_t>(n) == max_bytes)
+        return sec::end_of_stream;
       auto c = streambuf_.sbumpc();
       using traits = typename streambuf_type::traits_type;
       if (traits::eq_int_type(c, traits::eof()))
@@ -134,14 +150,17 @@ protected:
         CAF_ASSERT(type == i8_v || type == u8_v);
         return apply_raw(sizeof(uint8_t), val);
       case i16_v:
+        return apply_signed(*reinterpret_cast<int16_t*>(val));
       case u16_v:
-        return apply_int(*reinterpret_cast<uint16_t*>(val));
+        return apply_unsigned(*reinterpret_cast<uint16_t*>(val));
       case i32_v:
+        return apply_signed(*reinterpret_cast<int32_t*>(val));
       case u32_v:
-        return apply_int(*reinterpret_cast<uint32_t*>(val));
+        return apply_unsigned(*reinterpret_cast<uint32_t*>(val));
       case i64_v:
+        return apply_signed(*reinterpret_cast<int64_t*>(val));
       case u64_v:
-        return apply_int(*reinterpret_cast<uint64_t*>(val));
+        return apply_unsigned(*reinterpret_cast<uint64_t*>(val));
       case float_v:
         return apply_float(*reinterpret_cast<float*>(val));
       case double_v:
@@ -205,6 +224,25 @@ protected:
     return none;
   }
 
+  template <class T>
+  error apply_unsigned(T& x) {
+    if (varint_encoding_)
+      return varbyte_decode(x);
+    return apply_int(x);
+  }
+
+  template <class T>
+  error apply_signed(T& x) {
+    using unsigned_type = typename std::make_unsigned<T>::type;
+    unsigned_type tmp = 0;
+    auto e = varint_encoding_ ? varbyte_decode(tmp) : apply_int(tmp);
+    if (e)
+      return e;
+    x = varint_encoding_ ? detail::zigzag_decode(tmp)
+                         : static_cast<T>(tmp);
+    return none;
+  }
+
   template <class T>
   error apply_float(T& x) {
     typename detail::ieee_754_trait<T>::packed_type tmp = 0;
@@ -217,6 +255,7 @@ protected:
 
 private:
   Streambuf streambuf_;
+  bool varint_encoding_ = false;
 };
 
 } // namespace caf
@@ -34,6 +34,7 @@
 
 #include "caf/detail/ieee_754.hpp"
 #include "caf/detail/network_order.hpp"
+#include "caf/detail/zigzag.hpp"
 
 namespace caf {
 
@@ -73,6 +74,18 @@ public:
       streambuf_(std::forward<S>(sb)) {
   }
 
+  /// Enables or disables variable-length encoding for 16, 32 and 64-bit
+  /// integers. Signed integers get zigzag-encoded first to keep small negative
+  /// values short. The deserializer must use the same setting.
+  void varint_encoding(bool x) {
+    varint_encoding_ = x;
+  }
+
+  /// Returns whether this serializer uses variable-length integer encoding.
+  bool varint_encoding() const {
+    return varint_encoding_;
+  }
+
   error begin_object(uint16_t& typenr, std::string& name) override {
     return error::eval([&] { return apply(typenr); },
                        [&] { return typenr == 0 ? apply(name) : error{}; });
@@ -132,14 +145,17 @@ protected:
         CAF_ASSERT(type == i8_v || type == u8_v);
         return apply_raw(sizeof(uint8_t), val);
       case i16_v:
+        return apply_signed(*reinterpret_cast<int16_t*>(val));
       case u16_v:
-        return apply_int(*reinterpret_cast<uint16_t*>(val));
+        return apply_unsigned(*reinterpret_cast<uint16_t*>(val));
       case i32_v:
+        return apply_signed(*reinterpret_cast<int32_t*>(val));
       case u32_v:
-        return apply_int(*reinterpret_cast<uint32_t*>(val));
+        return apply_unsigned(*reinterpret_cast<uint32_t*>(val));
       case i64_v:
+        return apply_signed(*reinterpret_cast<int64_t*>(val));
       case u64_v:
-        return apply_int(*reinterpret_cast<uint64_t*>(val));
+        return apply_unsigned(*reinterpret_cast<uint64_t*>(val));
       case float_v:
         return apply_int(detail::pack754(*reinterpret_cast<float*>(val)));
       case double_v:
@@ -187,8 +203,24 @@ protected:
     return apply_raw(sizeof(T), &y);
   }
 
+  template <class T>
+  error apply_unsigned(T x) {
+    if (varint_encoding_)
+      return varbyte_encode(x);
+    return apply_int(x);
+  }
+
+  template <class T>
+  error apply_signed(T x) {
+    if (varint_encoding_)
+      return varbyte_encode(detail::zigzag_encode(x));
+    using unsigned_type = typename std::make_unsigned<T>::type;
+    return apply_int(static_cast<unsigned_type>(x));
+  }
+
 private:
   Streambuf streambuf_;
+  bool varint_encoding_ = false;
 };
 
 } // namespace caf
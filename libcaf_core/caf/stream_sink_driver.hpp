@@ -22,6 +22,7 @@
 #include <tuple>
 #include <vector>
 
+#include "caf/column_batch.hpp"
 #include "caf/fwd.hpp"
 #include "caf/make_message.hpp"
 #include "caf/message.hpp"
@@ -61,6 +62,14 @@ public:
   /// Processes a single batch.
   virtual void process(std::vector<input_type>& batch) = 0;
 
+  /// Processes a single batch in columnar representation. The default
+  /// implementation converts the batch to a sequence of `input_type` values
+  /// and calls `process`.
+  virtual void process_columns(column_batch<input_type>& batch) {
+    auto xs = batch.to_rows();
+    process(xs);
+  }
+
   /// Can mark the sink as congested, e.g., when writing into a buffer that
   /// fills up faster than it is drained.
   virtual bool congested() const noexcept {
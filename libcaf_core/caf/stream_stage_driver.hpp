@@ -22,6 +22,7 @@
 #include <tuple>
 #include <vector>
 
+#include "caf/column_batch.hpp"
 #include "caf/fwd.hpp"
 #include "caf/message.hpp"
 
@@ -67,6 +68,15 @@ public:
   virtual void process(downstream<output_type>& out,
                        std::vector<input_type>& batch) = 0;
 
+  /// Processes a single batch in columnar representation. The default
+  /// implementation converts the batch to a sequence of `input_type` values
+  /// and calls `process`.
+  virtual void process_columns(downstream<output_type>& out,
+                               column_batch<input_type>& batch) {
+    auto xs = batch.to_rows();
+    process(out, xs);
+  }
+
   /// Cleans up any state.
   virtual void finalize(const error&) {
     // nop
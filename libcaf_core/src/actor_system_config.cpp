@@ -155,7 +155,8 @@ actor_system_config::actor_system_config()
        "sets whether a separate thread is used for I/O");
   opt_group{custom_options_, "middleman"}
   .add(middleman_network_backend, "network-backend",
-       "sets the network backend to either 'default' or 'asio' (if available)")
+       "sets the network backend to 'default', 'uring' (Linux only) or "
+       "'asio' (if available)")
   .add(middleman_app_identifier, "app-identifier",
        "sets the application identifier of this node")
   .add(middleman_enable_automatic_connections, "enable-automatic-connections",
@@ -177,7 +178,62 @@ actor_system_config::actor_system_config()
   .add(middleman_max_pending_msgs, "max-pending-messages",
        "sets the maximum for reordering of UDP receive buffers (default: 10)")
   .add<bool>("disable-tcp", "disables communication via TCP")
-  .add<bool>("enable-udp", "enable communication via UDP");
+  .add<bool>("enable-udp", "enable communication via UDP")
+  .add<bool>("enable-varint-encoding",
+             "offers variable-length integer encoding to BASP peers")
+  .add<bool>("enable-compact-headers",
+             "offers compact BASP headers with node aliases to TCP peers")
+  .add<size_t>("flush-threshold",
+               "coalesces BASP writes until reaching N bytes (0 disables)")
+  .add<timespan>("max-flush-delay",
+                 "sets the maximum delay for coalesced BASP writes "
+                 "(0 flushes after each batch)")
+  .add<bool>("enable-parallel-deserialization",
+             "deserializes inbound BASP messages on scheduler workers")
+  .add<bool>("enable-framed-reads",
+             "reads ahead on BASP connections and handles all complete "
+             "messages of a read at once")
+  .add<size_t>("multiplexer-threads",
+               "sets the number of multiplexer threads for brokers "
+               "(default: 1)")
+  .add<size_t>("datagram-batch-size",
+               "sets the number of datagrams per system call for UDP "
+               "sockets (default: 1, max: 64)")
+  .add<size_t>("buffer-pool-size",
+               "sets the maximum number of bytes cached for reuse by socket "
+               "buffers, idle sockets release their buffers to this pool "
+               "(default: 0, i.e., disabled)")
+  .add<std::string>("unix-socket-dir",
+                    "publishes actors also on Unix domain sockets in this "
+                    "directory and uses them for nodes on the same host")
+  .add<size_t>("connections-per-peer",
+               "sets the number of connections to each directly connected "
+               "node, all but the first carry the messages of actors "
+               "(default: 1)")
+  .add<size_t>("fragment-size",
+               "splits messages with larger payloads into fragments of this "
+               "size and interleaves them with other traffic (default: 0, "
+               "i.e., disabled)")
+  .add<size_t>("high-watermark",
+               "applies backpressure to senders once this many bytes await "
+               "transmission on a connection (default: 0, i.e., disabled)")
+  .add<size_t>("low-watermark",
+               "releases backpressure once the buffered bytes fall to this "
+               "value (default: 0, i.e., half of high-watermark)")
+  .add<atom_value>("backpressure",
+                   "sets the backpressure policy for congested connections: "
+                   "'drop', 'error' or 'pause' (default)")
+  .add<bool>("enable-reliable-udp",
+             "offers acknowledged datagrams with retransmissions and "
+             "congestion control to UDP peers")
+  .add<size_t>("reliable-udp-window",
+               "sets the maximum number of unacknowledged datagrams per "
+               "reliable UDP endpoint (default: 64, max: 64)")
+  .add<atom_value>("compression",
+                   "compresses batches of BASP messages to TCP peers with "
+                   "this codec: 'none' (default) or 'lz'")
+  .add<size_t>("compression-threshold",
+               "sends batches with less bytes uncompressed (default: 512)");
   opt_group(custom_options_, "opencl")
   .add(opencl_device_ids, "device-ids",
        "restricts which OpenCL devices are accessed by CAF");
@@ -0,0 +1,63 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/column_type.hpp"
+
+#include "caf/detail/enum_to_string.hpp"
+
+namespace caf {
+
+namespace {
+
+const char* column_type_strings[] = {
+  "int8",
+  "int16",
+  "int32",
+  "int64",
+  "uint8",
+  "uint16",
+  "uint32",
+  "uint64",
+  "float32",
+  "float64"
+};
+
+} // namespace <anonymous>
+
+std::string to_string(column_type x) {
+  return detail::enum_to_string(x, column_type_strings);
+}
+
+size_t element_size(column_type x) {
+  switch (x) {
+    case column_type::int8:
+    case column_type::uint8:
+      return 1;
+    case column_type::int16:
+    case column_type::uint16:
+      return 2;
+    case column_type::int32:
+    case column_type::uint32:
+    case column_type::float32:
+      return 4;
+    default:
+      return 8;
+  }
+}
+
+} // namespace caf
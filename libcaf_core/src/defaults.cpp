@@ -91,6 +91,19 @@ const size_t max_consecutive_reads = 50;
 const size_t heartbeat_interval = 0;
 const size_t cached_udp_buffers = 10;
 const size_t max_pending_msgs = 10;
+const size_t flush_threshold = 0;
+const timespan max_flush_delay = timespan{0};
+const size_t multiplexer_threads = 1;
+const size_t datagram_batch_size = 1;
+const size_t buffer_pool_size = 0;
+const size_t connections_per_peer = 1;
+const size_t fragment_size = 0;
+const size_t high_watermark = 0;
+const size_t low_watermark = 0;
+const atom_value backpressure = atom("pause");
+const size_t reliable_udp_window = 64;
+const atom_value compression = atom("none");
+const size_t compression_threshold = 512;
 
 } // namespace middleman
 
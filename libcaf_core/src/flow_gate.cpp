@@ -0,0 +1,65 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#include "caf/flow_gate.hpp"
+
+#include "caf/actor_cast.hpp"
+#include "caf/scheduled_actor.hpp"
+
+namespace caf {
+
+flow_gate::flow_gate(mode policy) : policy_(policy), closed_(false) {
+  // nop
+}
+
+flow_gate::~flow_gate() {
+  // Never leave any actor suspended.
+  open();
+}
+
+void flow_gate::close() {
+  std::unique_lock<std::mutex> guard{mtx_};
+  closed_ = true;
+}
+
+void flow_gate::open() {
+  std::vector<strong_actor_ptr> xs;
+  { // lifetime scope of guard
+    std::unique_lock<std::mutex> guard{mtx_};
+    closed_ = false;
+    xs.swap(parked_);
+  }
+  for (auto& x : xs)
+    static_cast<scheduled_actor*>(actor_cast<abstract_actor*>(x))->unpause();
+}
+
+bool flow_gate::park(scheduled_actor* self) {
+  std::unique_lock<std::mutex> guard{mtx_};
+  if (!closed_)
+    return false;
+  parked_.emplace_back(self->ctrl());
+  return true;
+}
+
+size_t flow_gate::parked() const {
+  std::unique_lock<std::mutex> guard{mtx_};
+  return parked_.size();
+}
+
+} // namespace caf
@@ -24,12 +24,15 @@
 #include "caf/locks.hpp"
 #include "caf/logger.hpp"
 #include "caf/mailbox_element.hpp"
+#include "caf/scheduled_actor.hpp"
 
 namespace caf {
 
-forwarding_actor_proxy::forwarding_actor_proxy(actor_config& cfg, actor dest)
+forwarding_actor_proxy::forwarding_actor_proxy(actor_config& cfg, actor dest,
+                                               flow_gate_ptr gate)
     : actor_proxy(cfg),
-      broker_(std::move(dest)) {
+      broker_(std::move(dest)),
+      gate_(std::move(gate)) {
   // nop
 }
 
@@ -59,10 +62,38 @@ void forwarding_actor_proxy::enqueue(mailbox_element_ptr what,
                                      execution_unit*) {
   CAF_PUSH_AID(0);
   CAF_ASSERT(what);
+  // Responses and system messages always pass a closed gate.
+  if (gate_ != nullptr && gate_->closed() && what->mid.is_default_message()
+      && !what->mid.is_response() && !apply_backpressure(*what))
+    return;
   forward_msg(std::move(what->sender), what->mid,
               what->move_content_to_message(), &what->stages);
 }
 
+bool forwarding_actor_proxy::apply_backpressure(mailbox_element& x) {
+  switch (gate_->policy()) {
+    case flow_gate::mode::drop:
+      CAF_LOG_DEBUG("drop message to congested node:" << CAF_ARG(x));
+      return false;
+    case flow_gate::mode::error:
+      CAF_LOG_DEBUG("reject message to congested node:" << CAF_ARG(x));
+      if (x.sender && x.mid.is_request())
+        x.sender->enqueue(nullptr, x.mid.response_id(),
+                          make_message(make_error(sec::remote_node_congested)),
+                          nullptr);
+      return false;
+    case flow_gate::mode::pause:
+      if (x.sender) {
+        auto ptr = actor_cast<abstract_actor*>(x.sender);
+        auto self = dynamic_cast<scheduled_actor*>(ptr);
+        if (self != nullptr)
+          self->pause_until(gate_);
+      }
+      return true;
+  }
+  return true;
+}
+
 bool forwarding_actor_proxy::add_backlink(abstract_actor* x) {
   if (monitorable_actor::add_backlink(x)) {
     forward_msg(ctrl(), invalid_message_id,
@@ -21,6 +21,7 @@
 #include "caf/actor_ostream.hpp"
 #include "caf/actor_system_config.hpp"
 #include "caf/config.hpp"
+#include "caf/flow_gate.hpp"
 #include "caf/inbound_path.hpp"
 #include "caf/to_string.hpp"
 
@@ -72,6 +73,11 @@ result<message> drop_after_quit(scheduled_actor* self, message_view&) {
   return make_message();
 }
 
+// Values for `scheduled_actor::pause_state_`.
+constexpr int not_paused = 0;
+constexpr int pausing = 1;
+constexpr int paused = 2;
+
 } // namespace
 
 // -- static helper functions --------------------------------------------------
@@ -120,7 +126,9 @@ scheduled_actor::scheduled_actor(actor_config& cfg)
       error_handler_(default_error_handler),
       down_handler_(default_down_handler),
       exit_handler_(default_exit_handler),
-      private_thread_(nullptr)
+      private_thread_(nullptr),
+      pause_gate_(nullptr),
+      pause_state_(0)
 # ifndef CAF_NO_EXCEPTIONS
       , exception_handler_(default_exception_handler)
 # endif // CAF_NO_EXCEPTIONS
@@ -146,6 +154,9 @@ scheduled_actor::~scheduled_actor() {
   // unrachable and can be destroyed as well
   if (private_thread_ != nullptr)
     private_thread_->notify_self_destroyed();
+  auto gate = pause_gate_.load();
+  if (gate != nullptr)
+    intrusive_ptr_release(gate);
 }
 
 // -- overridden functions of abstract_actor -----------------------------------
@@ -160,17 +171,7 @@ void scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
   switch (mailbox().push_back(std::move(ptr))) {
     case intrusive::inbox_result::unblocked_reader: {
       CAF_LOG_ACCEPT_EVENT(true);
-      // add a reference count to this actor and re-schedule it
-      intrusive_ptr_add_ref(ctrl());
-      if (getf(is_detached_flag)) {
-        CAF_ASSERT(private_thread_ != nullptr);
-        private_thread_->resume();
-      } else {
-        if (eu != nullptr)
-          eu->exec_later(this);
-        else
-          home_system().scheduler().enqueue(this);
-      }
+      schedule(eu);
       break;
     }
     case intrusive::inbox_result::queue_closed: {
@@ -386,10 +387,31 @@ scheduled_actor::resume(execution_unit* ctx, size_t max_throughput) {
       set_stream_timeout(tout);
     }
   };
+  // Parks this actor at the gate from `pause_until` if it is still closed.
+  auto try_pause = [&] {
+    if (pause_gate_.load(std::memory_order_relaxed) == nullptr)
+      return false;
+    flow_gate_ptr gate{pause_gate_.exchange(nullptr), false};
+    if (!gate)
+      return false;
+    pause_state_ = pausing;
+    if (!gate->park(this)) {
+      pause_state_ = not_paused;
+      return false;
+    }
+    // Fails if the gate opened in the meantime, i.e., we simply keep going.
+    auto expected = pausing;
+    return pause_state_.compare_exchange_strong(expected, paused);
+  };
   mailbox_visitor f{this, handled_msgs, max_throughput};
   mailbox_element_ptr ptr;
   // Timeout for calling `advance_streams`.
   while (handled_msgs < max_throughput) {
+    // Stop handling messages while waiting for a flow gate.
+    if (try_pause()) {
+      reset_timeouts_if_needed();
+      return resumable::awaiting_message;
+    }
     CAF_LOG_DEBUG("start new DRR round");
     // TODO: maybe replace '3' with configurable / adaptive value?
     // Dispatch on the different message categories in our mailbox.
@@ -415,6 +437,34 @@ scheduled_actor::resume(execution_unit* ctx, size_t max_throughput) {
   return resumable::resume_later;
 }
 
+// -- scheduling ---------------------------------------------------------------
+
+void scheduled_actor::schedule(execution_unit* eu) {
+  // add a reference count to this actor and re-schedule it
+  intrusive_ptr_add_ref(ctrl());
+  if (getf(is_detached_flag)) {
+    CAF_ASSERT(private_thread_ != nullptr);
+    private_thread_->resume();
+  } else {
+    if (eu != nullptr)
+      eu->exec_later(this);
+    else
+      home_system().scheduler().enqueue(this);
+  }
+}
+
+void scheduled_actor::unpause() {
+  CAF_LOG_TRACE("");
+  auto expected = paused;
+  if (pause_state_.compare_exchange_strong(expected, not_paused)) {
+    schedule(nullptr);
+    return;
+  }
+  // Still running: tell `resume` to continue instead of suspending.
+  expected = pausing;
+  pause_state_.compare_exchange_strong(expected, not_paused);
+}
+
 // -- scheduler callbacks ------------------------------------------------------
 
 proxy_registry* scheduled_actor::proxy_registry_ptr() {
@@ -461,6 +511,13 @@ void scheduled_actor::quit(error x) {
   }
 }
 
+void scheduled_actor::pause_until(flow_gate_ptr gate) {
+  CAF_ASSERT(gate != nullptr);
+  auto old = pause_gate_.exchange(gate.release());
+  if (old != nullptr)
+    intrusive_ptr_release(old);
+}
+
 // -- timeout management -------------------------------------------------------
 
 uint64_t scheduled_actor::set_receive_timeout(actor_clock::time_point x) {
@@ -0,0 +1,105 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE batch_pool
+
+#include "caf/test/unit_test.hpp"
+
+#include <vector>
+
+#include "caf/make_counted.hpp"
+
+#include "caf/detail/batch_pool.hpp"
+
+using namespace caf;
+
+using caf::detail::batch_pool;
+
+namespace {
+
+using batch_type = std::vector<int>;
+
+struct fixture {
+  fixture() : pool(make_counted<batch_pool<int>>(2)) {
+    // nop
+  }
+
+  message make_batch(int first, int last) {
+    std::vector<int> xs;
+    for (int i = first; i <= last; ++i)
+      xs.push_back(i);
+    return pool->make_batch(xs.begin(), xs.end());
+  }
+
+  detail::batch_pool_ptr<int> pool;
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(batch_pool_tests, fixture)
+
+CAF_TEST(batches are regular messages) {
+  auto msg = make_batch(1, 3);
+  CAF_REQUIRE(msg.match_elements<batch_type>());
+  CAF_CHECK_EQUAL(msg.get_as<batch_type>(0), batch_type({1, 2, 3}));
+  CAF_CHECK_EQUAL(to_string(msg), "([1, 2, 3])");
+}
+
+CAF_TEST(dropping a batch returns its slab) {
+  CAF_CHECK_EQUAL(pool->idle(), 0u);
+  auto msg = make_batch(1, 10);
+  auto copy = msg;
+  msg.reset();
+  CAF_CHECK_EQUAL(pool->idle(), 0u);
+  copy.reset();
+  CAF_CHECK_EQUAL(pool->idle(), 1u);
+  msg = make_batch(11, 15);
+  CAF_CHECK_EQUAL(pool->reused(), 1u);
+  CAF_CHECK_EQUAL(pool->idle(), 0u);
+  CAF_CHECK_EQUAL(msg.get_as<batch_type>(0), batch_type({11, 12, 13, 14, 15}));
+}
+
+CAF_TEST(the pool caches a limited number of slabs) {
+  std::vector<message> msgs;
+  for (int i = 0; i < 5; ++i)
+    msgs.emplace_back(make_batch(1, 5));
+  msgs.clear();
+  CAF_CHECK_EQUAL(pool->idle(), 2u);
+}
+
+CAF_TEST(receivers may steal the content of a batch) {
+  auto msg = make_batch(1, 5);
+  auto xs = std::move(msg.get_mutable_as<batch_type>(0));
+  msg.reset();
+  CAF_CHECK_EQUAL(xs, batch_type({1, 2, 3, 4, 5}));
+  CAF_CHECK_EQUAL(pool->idle(), 0u);
+}
+
+CAF_TEST(copy on write detaches from the pool) {
+  auto msg = make_batch(1, 5);
+  auto copy = msg;
+  copy.get_mutable_as<batch_type>(0).push_back(6);
+  CAF_CHECK_EQUAL(msg.get_as<batch_type>(0).size(), 5u);
+  CAF_CHECK_EQUAL(copy.get_as<batch_type>(0).size(), 6u);
+  msg.reset();
+  CAF_CHECK_EQUAL(pool->idle(), 1u);
+  copy.reset();
+  CAF_CHECK_EQUAL(pool->idle(), 1u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -224,6 +224,14 @@ struct fixture {
     return result;
   }
 
+  // Returns the content of the first batch in the mailbox of `x`.
+  const void* first_batch_data(entity& x) {
+    CAF_REQUIRE(!x.mbox.empty());
+    auto& dm = x.mbox.front().get_as<downstream_msg>(0);
+    CAF_REQUIRE(holds_alternative<downstream_msg::batch>(dm.content));
+    return get<downstream_msg::batch>(dm.content).xs.cvals().get();
+  }
+
   batch_type make_batch(int first, int last) {
     batch_type result;
     result.resize(static_cast<size_t>((last + 1) - first));
@@ -517,4 +525,84 @@ CAF_TEST(two_paths_different_sizes_without_force) {
   }
 }
 
+CAF_TEST(two_paths_shared_batches_force) {
+  // Same setup as above, but with batches shared by bob and carl. Shared
+  // batches use the smallest desired batch size.
+  alice.add_path_to(bob, 10);
+  alice.add_path_to(carl, 7);
+  alice.mgr.out().shared_batches(true);
+  for (int i = 1; i <= 100; ++i)
+    alice.mgr.out().push(i);
+  AFTER ENTITY alice TRIED FORCE_SENDING 3 ELEMENTS {
+    CAF_CHECK_EQUAL(first_batch_data(bob), first_batch_data(carl));
+    ENTITY bob RECEIVED BATCH(1, 3);
+    ENTITY carl RECEIVED BATCH(1, 3);
+    ENTITY alice HAS 0u CREDIT TOTAL;
+  }
+  AFTER ENTITY alice TRIED FORCE_SENDING 10 ELEMENTS {
+    ENTITY bob RECEIVED BATCH(4, 10) AND BATCH(11, 13);
+    ENTITY carl RECEIVED BATCH(4, 10) AND BATCH(11, 13);
+    ENTITY alice HAS 0u CREDIT TOTAL;
+  }
+  AFTER ENTITY alice TRIED FORCE_SENDING 100 ELEMENTS {
+    ENTITY bob RECEIVED some;
+    ENTITY carl RECEIVED some;
+    ENTITY alice HAS 13u CREDIT FOR bob;
+    ENTITY alice HAS 13u CREDIT FOR carl;
+  }
+  CAF_CHECK_EQUAL(alice.mgr.out().buffered(), 0u);
+}
+
+CAF_TEST(two_paths_shared_batches_without_force) {
+  alice.add_path_to(bob, 10);
+  alice.add_path_to(carl, 7);
+  alice.mgr.out().shared_batches(true);
+  for (int i = 1; i <= 100; ++i)
+    alice.mgr.out().push(i);
+  // Give 3 credit (less than 7).
+  AFTER ENTITY alice TRIED SENDING 3 ELEMENTS {
+    ENTITY bob RECEIVED none;
+    ENTITY carl RECEIVED none;
+    ENTITY alice HAS 6u CREDIT TOTAL;
+  }
+  // Give 4 more credit.
+  AFTER ENTITY alice TRIED SENDING 4 ELEMENTS {
+    ENTITY bob RECEIVED BATCH(1, 7);
+    ENTITY carl RECEIVED BATCH(1, 7);
+    ENTITY alice HAS 0u CREDIT TOTAL;
+  }
+  // Give 10 credit.
+  AFTER ENTITY alice TRIED SENDING 10 ELEMENTS {
+    ENTITY bob RECEIVED BATCH(8, 14);
+    ENTITY carl RECEIVED BATCH(8, 14);
+    ENTITY alice HAS 3u CREDIT FOR bob;
+    ENTITY alice HAS 3u CREDIT FOR carl;
+  }
+  // Elements not yet shipped remain in the central buffer only.
+  CAF_CHECK_EQUAL(alice.mgr.out().buffered(), 86u);
+}
+
+CAF_TEST(switching_to_shared_batches) {
+  alice.add_path_to(bob, 10);
+  alice.add_path_to(carl, 7);
+  for (int i = 1; i <= 100; ++i)
+    alice.mgr.out().push(i);
+  // Leave elements 8 to 10 in carl's buffer.
+  AFTER ENTITY alice TRIED SENDING 10 ELEMENTS {
+    ENTITY bob RECEIVED BATCH(1, 10);
+    ENTITY carl RECEIVED BATCH(1, 7);
+  }
+  alice.mgr.out().shared_batches(true);
+  // Carl's leftovers force one more round with per-path buffers.
+  AFTER ENTITY alice TRIED SENDING 4 ELEMENTS {
+    ENTITY bob RECEIVED none;
+    ENTITY carl RECEIVED BATCH(8, 14);
+  }
+  // Bob's buffer drains before the manager starts sharing batches.
+  AFTER ENTITY alice TRIED FORCE_SENDING 3 ELEMENTS {
+    ENTITY bob RECEIVED BATCH(11, 14) AND BATCH(15, 17);
+    ENTITY carl RECEIVED BATCH(15, 17);
+  }
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,293 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE column_batch
+
+#include "caf/column_batch.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include <string>
+#include <vector>
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/binary_deserializer.hpp"
+#include "caf/binary_serializer.hpp"
+#include "caf/columnar_downstream_manager.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/stateful_actor.hpp"
+#include "caf/stream_sink_driver.hpp"
+
+using std::string;
+
+using namespace caf;
+
+namespace {
+
+struct point {
+  int32_t x;
+  double y;
+};
+
+bool operator==(const point& a, const point& b) {
+  return a.x == b.x && a.y == b.y;
+}
+
+template <class Inspector>
+typename Inspector::result_type inspect(Inspector& f, point& x) {
+  return f(meta::type_name("point"), x.x, x.y);
+}
+
+struct segment {
+  point from;
+  point to;
+  uint8_t tag;
+};
+
+bool operator==(const segment& a, const segment& b) {
+  return a.from == b.from && a.to == b.to && a.tag == b.tag;
+}
+
+template <class Inspector>
+typename Inspector::result_type inspect(Inspector& f, segment& x) {
+  return f(meta::type_name("segment"), x.from, x.to, x.tag);
+}
+
+struct named_point {
+  string name;
+  point pos;
+};
+
+template <class Inspector>
+typename Inspector::result_type inspect(Inspector& f, named_point& x) {
+  return f(meta::type_name("named_point"), x.name, x.pos);
+}
+
+using points = std::vector<point>;
+
+using downstream_manager = columnar_downstream_manager<point>;
+
+points make_points(size_t n) {
+  points result;
+  for (size_t i = 0; i < n; ++i)
+    result.push_back(point{static_cast<int32_t>(i), i / 2.});
+  return result;
+}
+
+TESTEE_SETUP();
+
+VARARGS_TESTEE(point_source, size_t num) {
+  return {
+    [=](string&) -> output_stream<point> {
+      return self->make_source(
+        [=](points& xs) {
+          xs = make_points(num);
+        },
+        [](points& xs, downstream<point>& out, size_t hint) {
+          auto n = std::min(hint, xs.size());
+          for (size_t i = 0; i < n; ++i)
+            out.push(xs[i]);
+          xs.erase(xs.begin(), xs.begin() + static_cast<ptrdiff_t>(n));
+        },
+        [](const points& xs) {
+          return xs.empty();
+        },
+        unit,
+        policy::arg<downstream_manager>::value
+      );
+    }
+  };
+}
+
+TESTEE(point_forwarder) {
+  return {
+    [=](const stream<point>& in) {
+      return self->make_stage(
+        in,
+        [](unit_t&) {
+          // nop
+        },
+        [](unit_t&, downstream<point>& out, point x) {
+          out.push(x);
+        },
+        unit,
+        policy::arg<downstream_manager>::value
+      );
+    }
+  };
+}
+
+TESTEE_STATE(point_sink) {
+  points xs;
+  size_t column_batches = 0;
+};
+
+// Reads the columns directly instead of converting the batch to rows.
+class point_sink_driver : public stream_sink_driver<point> {
+public:
+  point_sink_driver(points& xs, size_t& column_batches)
+      : xs_(xs),
+        column_batches_(column_batches) {
+    // nop
+  }
+
+  void process(std::vector<point>& xs) override {
+    xs_.insert(xs_.end(), xs.begin(), xs.end());
+  }
+
+  void process_columns(column_batch<point>& xs) override {
+    ++column_batches_;
+    auto x = xs.column<int32_t>(0);
+    auto y = xs.column<double>(1);
+    for (size_t i = 0; i < xs.rows(); ++i)
+      xs_.push_back(point{x[i], y[i]});
+  }
+
+private:
+  points& xs_;
+  size_t& column_batches_;
+};
+
+TESTEE(point_sink) {
+  return {
+    [=](const stream<point>& in) {
+      auto& st = self->state;
+      return self->make_sink<point_sink_driver>(in, st.xs, st.column_batches);
+    }
+  };
+}
+
+struct fixture : test_coordinator_fixture<> {
+  template <class T>
+  std::vector<char> serialize(T& x) {
+    std::vector<char> buf;
+    binary_serializer sink{sys, buf};
+    if (auto err = sink(x))
+      CAF_FAIL("serialization failed: " << sys.render(err));
+    return buf;
+  }
+
+  template <class T>
+  error deserialize(std::vector<char>& buf, T& x) {
+    binary_deserializer source{sys, buf};
+    return source(x);
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(column_batch_tests, fixture)
+
+CAF_TEST(layouts) {
+  using types = std::vector<column_type>;
+  CAF_CHECK(column_batch<int>::columnar());
+  CAF_CHECK_EQUAL(column_batch<int>::layout(), types{column_type::int32});
+  CAF_CHECK(column_batch<point>::columnar());
+  CAF_CHECK_EQUAL(column_batch<point>::layout(),
+                  types({column_type::int32, column_type::float64}));
+  CAF_CHECK(column_batch<segment>::columnar());
+  CAF_CHECK_EQUAL(column_batch<segment>::layout(),
+                  types({column_type::int32, column_type::float64,
+                         column_type::int32, column_type::float64,
+                         column_type::uint8}));
+  CAF_CHECK(!column_batch<string>::columnar());
+  CAF_CHECK(!column_batch<named_point>::columnar());
+}
+
+CAF_TEST(rows) {
+  auto xs = make_points(5);
+  column_batch<point> ys{xs.begin(), xs.end()};
+  CAF_CHECK_EQUAL(ys.rows(), 5u);
+  CAF_CHECK_EQUAL(ys.columns(), 2u);
+  CAF_CHECK_EQUAL(ys.row(3), xs[3]);
+  CAF_CHECK_EQUAL(ys.to_rows(), xs);
+  ys.clear();
+  CAF_CHECK(ys.empty());
+  CAF_CHECK(ys.to_rows().empty());
+}
+
+CAF_TEST(columns) {
+  auto xs = make_points(5);
+  column_batch<point> ys{xs.begin(), xs.end()};
+  auto x = ys.column<int32_t>(0);
+  auto y = ys.column<double>(1);
+  CAF_REQUIRE_EQUAL(x.size(), 5u);
+  CAF_REQUIRE_EQUAL(y.size(), 5u);
+  for (size_t i = 0; i < 5; ++i) {
+    CAF_CHECK_EQUAL(x[i], xs[i].x);
+    CAF_CHECK_EQUAL(y[i], xs[i].y);
+  }
+  CAF_MESSAGE("writing to a column changes the rows");
+  for (auto& z : x)
+    z *= 10;
+  CAF_CHECK_EQUAL(ys.row(2), (point{20, 1.}));
+  CAF_MESSAGE("resize appends zero-initialized rows");
+  ys.resize(7);
+  CAF_CHECK_EQUAL(ys.rows(), 7u);
+  CAF_CHECK_EQUAL(ys.row(6), (point{0, 0.}));
+  ys.column<double>(1)[6] = 4.5;
+  CAF_CHECK_EQUAL(ys.row(6), (point{0, 4.5}));
+}
+
+CAF_TEST(nested_types) {
+  std::vector<segment> xs{{{1, 2.}, {3, 4.}, 5}, {{6, 7.}, {8, 9.}, 10}};
+  column_batch<segment> ys{xs.begin(), xs.end()};
+  CAF_CHECK_EQUAL(ys.columns(), 5u);
+  CAF_CHECK_EQUAL(ys.column<int32_t>(2)[1], 8);
+  CAF_CHECK_EQUAL(ys.column<uint8_t>(4)[0], 5u);
+  CAF_CHECK_EQUAL(ys.to_rows(), xs);
+}
+
+CAF_TEST(serialization) {
+  std::vector<segment> xs{{{1, 2.}, {3, 4.}, 5}, {{6, 7.}, {8, 9.}, 10}};
+  column_batch<segment> ys{xs.begin(), xs.end()};
+  auto buf = serialize(ys);
+  column_batch<segment> zs;
+  CAF_CHECK_EQUAL(deserialize(buf, zs), none);
+  CAF_CHECK_EQUAL(zs, ys);
+  CAF_CHECK_EQUAL(zs.to_rows(), xs);
+  CAF_MESSAGE("deserializing into a different layout fails");
+  column_batch<point> ps;
+  CAF_CHECK_NOT_EQUAL(deserialize(buf, ps), none);
+}
+
+CAF_TEST(byte_order) {
+  column_batch<int32_t> xs;
+  xs.push_back(0x01020304);
+  auto buf = serialize(xs);
+  // The byte-order flag directly follows the 64-bit row count.
+  CAF_REQUIRE_GREATER(buf.size(), 8u);
+  buf[8] = buf[8] == 0 ? 1 : 0;
+  column_batch<int32_t> ys;
+  CAF_CHECK_EQUAL(deserialize(buf, ys), none);
+  CAF_CHECK_EQUAL(ys.column<int32_t>(0)[0], 0x04030201);
+}
+
+CAF_TEST(streaming) {
+  auto src = sys.spawn(point_source, 50u);
+  auto stg = sys.spawn(point_forwarder);
+  auto snk = sys.spawn(point_sink);
+  self->send(snk * stg * src, "points");
+  run();
+  auto& st = deref<point_sink_actor>(snk).state;
+  CAF_CHECK_EQUAL(st.xs, make_points(50));
+  CAF_CHECK_GREATER(st.column_batches, 0u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
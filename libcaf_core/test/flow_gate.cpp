@@ -0,0 +1,176 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE flow_gate
+#include "caf/test/dsl.hpp"
+
+#include "caf/flow_gate.hpp"
+#include "caf/forwarding_actor_proxy.hpp"
+
+using namespace caf;
+
+namespace {
+
+struct counter_state {
+  int received = 0;
+};
+
+// Waits for `gate` after receiving the first integer.
+behavior counter(stateful_actor<counter_state>* self, flow_gate_ptr gate) {
+  return {
+    [=](int) {
+      if (++self->state.received == 1)
+        self->pause_until(gate);
+    }
+  };
+}
+
+// Collects the content of all messages the proxy forwards.
+behavior broker_dummy(event_based_actor* self, std::vector<message>* buf) {
+  self->set_default_handler(drop);
+  return {
+    [=](forward_atom, const strong_actor_ptr&,
+        const std::vector<strong_actor_ptr>&, const strong_actor_ptr&,
+        message_id, message& msg) {
+      buf->emplace_back(std::move(msg));
+    }
+  };
+}
+
+struct fixture : test_coordinator_fixture<> {
+  int received(const actor& x) {
+    return deref<stateful_actor<counter_state>>(x).state.received;
+  }
+
+  strong_actor_ptr make_proxy(actor dest, flow_gate_ptr gate) {
+    actor_config cfg;
+    return make_actor<forwarding_actor_proxy, strong_actor_ptr>(
+      actor_id{42}, sys.node(), &sys, cfg, std::move(dest), std::move(gate));
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(flow_gate_tests, fixture)
+
+CAF_TEST(actors park at closed gates only) {
+  auto gate = make_counted<flow_gate>();
+  auto testee = sys.spawn(counter, gate);
+  sched.run();
+  auto ptr = &deref<scheduled_actor>(testee);
+  CAF_CHECK(!gate->closed());
+  CAF_CHECK(!gate->park(ptr));
+  gate->close();
+  CAF_CHECK(gate->closed());
+  CAF_CHECK(gate->park(ptr));
+  CAF_CHECK_EQUAL(gate->parked(), 1u);
+  gate->open();
+  CAF_CHECK_EQUAL(gate->parked(), 0u);
+  // The testee never suspended itself, i.e., opening the gate has no effect.
+  CAF_CHECK(!sched.has_job());
+}
+
+CAF_TEST(paused actors resume after opening the gate) {
+  auto gate = make_counted<flow_gate>();
+  gate->close();
+  auto testee = sys.spawn(counter, gate);
+  sched.run();
+  for (int i = 0; i < 3; ++i)
+    self->send(testee, i);
+  sched.run();
+  CAF_CHECK_EQUAL(received(testee), 1);
+  CAF_CHECK_EQUAL(gate->parked(), 1u);
+  CAF_CHECK(!sched.has_job());
+  gate->open();
+  sched.run();
+  CAF_CHECK_EQUAL(received(testee), 3);
+}
+
+CAF_TEST(open gates do not pause actors) {
+  auto gate = make_counted<flow_gate>();
+  auto testee = sys.spawn(counter, gate);
+  sched.run();
+  for (int i = 0; i < 3; ++i)
+    self->send(testee, i);
+  sched.run();
+  CAF_CHECK_EQUAL(received(testee), 3);
+  CAF_CHECK_EQUAL(gate->parked(), 0u);
+}
+
+CAF_TEST(proxies drop messages at closed gates) {
+  std::vector<message> buf;
+  auto broker = sys.spawn(broker_dummy, &buf);
+  auto gate = make_counted<flow_gate>(flow_gate::mode::drop);
+  auto proxy = make_proxy(broker, gate);
+  anon_send(actor_cast<actor>(proxy), 1);
+  gate->close();
+  anon_send(actor_cast<actor>(proxy), 2);
+  gate->open();
+  anon_send(actor_cast<actor>(proxy), 3);
+  sched.run();
+  CAF_REQUIRE_EQUAL(buf.size(), 2u);
+  CAF_CHECK_EQUAL(to_string(buf[0]), "(1)");
+  CAF_CHECK_EQUAL(to_string(buf[1]), "(3)");
+}
+
+CAF_TEST(proxies reject requests at closed gates) {
+  std::vector<message> buf;
+  auto broker = sys.spawn(broker_dummy, &buf);
+  auto gate = make_counted<flow_gate>(flow_gate::mode::error);
+  auto proxy = actor_cast<actor>(make_proxy(broker, gate));
+  gate->close();
+  self->request(proxy, infinite, 1).receive(
+    [](int) {
+      CAF_FAIL("unexpected response");
+    },
+    [](error& err) {
+      CAF_CHECK_EQUAL(err, sec::remote_node_congested);
+    }
+  );
+  sched.run();
+  CAF_CHECK(buf.empty());
+}
+
+CAF_TEST(proxies pause senders at closed gates) {
+  std::vector<message> buf;
+  auto broker = sys.spawn(broker_dummy, &buf);
+  auto gate = make_counted<flow_gate>(flow_gate::mode::pause);
+  auto proxy = actor_cast<actor>(make_proxy(broker, gate));
+  auto sender = sys.spawn([=](event_based_actor* self) -> behavior {
+    return {
+      [=](int x) {
+        self->send(proxy, x);
+      }
+    };
+  });
+  sched.run();
+  gate->close();
+  for (int i = 0; i < 3; ++i)
+    self->send(sender, i);
+  sched.run();
+  // The sender forwards its first message, then waits for the gate.
+  CAF_CHECK_EQUAL(buf.size(), 1u);
+  CAF_CHECK_EQUAL(gate->parked(), 1u);
+  gate->open();
+  sched.run();
+  CAF_CHECK_EQUAL(buf.size(), 3u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
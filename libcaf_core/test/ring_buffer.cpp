@@ -0,0 +1,165 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#define CAF_SUITE ring_buffer
+
+#include "caf/test/unit_test.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "caf/deep_to_string.hpp"
+
+#include "caf/detail/ring_buffer.hpp"
+
+using namespace caf;
+
+using caf::detail::ring_buffer;
+
+namespace {
+
+using int_buffer = ring_buffer<int>;
+
+std::vector<int> to_vector(const int_buffer& xs) {
+  return {xs.begin(), xs.end()};
+}
+
+std::vector<int> iota(int first, int last) {
+  std::vector<int> result;
+  for (int i = first; i <= last; ++i)
+    result.push_back(i);
+  return result;
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(default construction) {
+  int_buffer xs;
+  CAF_CHECK(xs.empty());
+  CAF_CHECK_EQUAL(xs.size(), 0u);
+  CAF_CHECK_EQUAL(xs.capacity(), 0u);
+  CAF_CHECK(xs.begin() == xs.end());
+}
+
+CAF_TEST(appending and erasing at the front) {
+  int_buffer xs;
+  for (int i = 1; i <= 10; ++i)
+    xs.push_back(i);
+  CAF_CHECK_EQUAL(to_vector(xs), iota(1, 10));
+  CAF_CHECK_EQUAL(xs.front(), 1);
+  CAF_CHECK_EQUAL(xs.back(), 10);
+  xs.erase(xs.begin(), xs.begin() + 4);
+  CAF_CHECK_EQUAL(to_vector(xs), iota(5, 10));
+  CAF_CHECK_EQUAL(xs[0], 5);
+  xs.pop_front();
+  CAF_CHECK_EQUAL(xs.front(), 6);
+  xs.pop_back();
+  CAF_CHECK_EQUAL(to_vector(xs), iota(6, 9));
+  xs.erase(xs.begin() + 2, xs.end());
+  CAF_CHECK_EQUAL(to_vector(xs), iota(6, 7));
+}
+
+CAF_TEST(wrapping around) {
+  int_buffer xs;
+  xs.reserve(8);
+  auto cap = xs.capacity();
+  int next = 1;
+  int expected_front = 1;
+  // Keep the buffer half full while moving through the array many times.
+  for (int round = 0; round < 100; ++round) {
+    while (xs.size() < cap / 2)
+      xs.push_back(next++);
+    xs.erase(xs.begin(), xs.begin() + 3);
+    expected_front += 3;
+    CAF_REQUIRE_EQUAL(xs.front(), expected_front);
+  }
+  // Wrapping around never allocates.
+  CAF_CHECK_EQUAL(xs.capacity(), cap);
+  CAF_CHECK_EQUAL(to_vector(xs), iota(expected_front, next - 1));
+}
+
+CAF_TEST(growing while wrapped) {
+  int_buffer xs;
+  for (int i = 1; i <= 16; ++i)
+    xs.push_back(i);
+  xs.erase(xs.begin(), xs.begin() + 10);
+  // The following elements wrap around before the buffer grows.
+  for (int i = 17; i <= 100; ++i)
+    xs.push_back(i);
+  CAF_CHECK_EQUAL(to_vector(xs), iota(11, 100));
+}
+
+CAF_TEST(inserting ranges) {
+  int_buffer xs{1, 2, 3};
+  auto ys = iota(4, 50);
+  auto i = xs.insert(xs.end(), ys.begin(), ys.end());
+  CAF_CHECK_EQUAL(*i, 4);
+  CAF_CHECK_EQUAL(to_vector(xs), iota(1, 50));
+  CAF_CHECK_GREATER_OR_EQUAL(xs.capacity(), 50u);
+}
+
+CAF_TEST(random access iterators) {
+  int_buffer xs;
+  for (int i = 1; i <= 20; ++i)
+    xs.push_back(i);
+  xs.erase(xs.begin(), xs.begin() + 5);
+  auto first = xs.begin();
+  auto last = xs.end();
+  CAF_CHECK_EQUAL(last - first, 15);
+  CAF_CHECK_EQUAL(first[3], 9);
+  CAF_CHECK_EQUAL(*(first + 14), 20);
+  CAF_CHECK_EQUAL(*(last - 1), 20);
+  CAF_CHECK(first < last);
+  int_buffer::const_iterator cfirst = first;
+  CAF_CHECK(cfirst == xs.cbegin());
+  std::vector<int> ys{std::make_move_iterator(first),
+                      std::make_move_iterator(last)};
+  CAF_CHECK_EQUAL(ys, iota(6, 20));
+}
+
+CAF_TEST(copy and move) {
+  int_buffer xs;
+  for (int i = 1; i <= 20; ++i)
+    xs.push_back(i);
+  xs.erase(xs.begin(), xs.begin() + 10);
+  int_buffer ys{xs};
+  CAF_CHECK(xs == ys);
+  int_buffer zs{std::move(ys)};
+  CAF_CHECK(ys.empty());
+  CAF_CHECK(xs == zs);
+  ys = zs;
+  CAF_CHECK(ys == zs);
+  xs.clear();
+  CAF_CHECK(xs.empty());
+  CAF_CHECK(xs != zs);
+}
+
+CAF_TEST(non trivial elements) {
+  ring_buffer<std::string> xs;
+  for (int i = 0; i < 40; ++i)
+    xs.emplace_back(std::to_string(i));
+  xs.erase(xs.begin(), xs.begin() + 35);
+  xs.push_back(xs.front());
+  CAF_CHECK_EQUAL(deep_to_string(xs), R"(["35", "36", "37", "38", "39", "35"])");
+  ring_buffer<std::unique_ptr<int>> ys;
+  for (int i = 0; i < 20; ++i)
+    ys.emplace_back(new int(i));
+  ys.erase(ys.begin(), ys.begin() + 19);
+  CAF_CHECK_EQUAL(*ys.front(), 19);
+}
@@ -475,6 +475,67 @@ CAF_TEST(long_sequences) {
   CAF_CHECK_EQUAL(n, m);
 }
 
+CAF_TEST(varint_integers) {
+  std::vector<char> buf;
+  binary_serializer sink{&context, buf};
+  sink.varint_encoding(true);
+  int16_t i16 = -1;
+  uint16_t u16 = 127;
+  uint32_t u32 = 128;
+  auto i64_min = std::numeric_limits<int64_t>::min();
+  auto u64_max = std::numeric_limits<uint64_t>::max();
+  auto e = sink(i16, u16, u32, i32, i64, i64_min, u64_max);
+  CAF_REQUIRE_EQUAL(e, none);
+  // -1 and 127 fit into one byte, 128 requires two bytes, -345 becomes 689
+  // and thus requires two bytes, and 64-bit values take up to 10 bytes
+  CAF_CHECK_EQUAL(buf.size(), 1u + 1u + 2u + 2u + 9u + 10u + 10u);
+  binary_deserializer source{&context, buf};
+  source.varint_encoding(true);
+  int16_t i16_2;
+  uint16_t u16_2;
+  uint32_t u32_2;
+  int32_t i32_2;
+  int64_t i64_2;
+  int64_t i64_min_2;
+  uint64_t u64_max_2;
+  e = source(i16_2, u16_2, u32_2, i32_2, i64_2, i64_min_2, u64_max_2);
+  CAF_REQUIRE_EQUAL(e, none);
+  CAF_CHECK_EQUAL(i16, i16_2);
+  CAF_CHECK_EQUAL(u16, u16_2);
+  CAF_CHECK_EQUAL(u32, u32_2);
+  CAF_CHECK_EQUAL(i32, i32_2);
+  CAF_CHECK_EQUAL(i64, i64_2);
+  CAF_CHECK_EQUAL(i64_min, i64_min_2);
+  CAF_CHECK_EQUAL(u64_max, u64_max_2);
+}
+
+CAF_TEST(varint_messages) {
+  auto m = make_message(uint16_t{42}, int32_t{-7}, uint64_t{1000}, ta, msg);
+  std::vector<char> fixed_buf;
+  binary_serializer fixed_sink{&context, fixed_buf};
+  CAF_REQUIRE_EQUAL(fixed_sink(m), none);
+  std::vector<char> varint_buf;
+  binary_serializer varint_sink{&context, varint_buf};
+  varint_sink.varint_encoding(true);
+  CAF_REQUIRE_EQUAL(varint_sink(m), none);
+  CAF_MESSAGE("fixed-width encoding: " << fixed_buf.size() << " bytes, "
+              << "variable-length encoding: " << varint_buf.size() << " bytes");
+  CAF_CHECK_LESS(varint_buf.size(), fixed_buf.size());
+  message x;
+  binary_deserializer source{&context, varint_buf};
+  source.varint_encoding(true);
+  CAF_REQUIRE_EQUAL(source(x), none);
+  CAF_CHECK_EQUAL(to_string(m), to_string(x));
+}
+
+CAF_TEST(varint_overlong_input) {
+  std::vector<char> buf(4, static_cast<char>(0xFF));
+  binary_deserializer source{&context, buf};
+  source.varint_encoding(true);
+  uint16_t x;
+  CAF_CHECK_EQUAL(source(x), sec::end_of_stream);
+}
+
 // -- our vector<bool> serialization packs into an uint64_t. Hence, the
 // critical sizes to test are 0, 1, 63, 64, and 65.
 
@@ -424,6 +424,7 @@ private:
   doorman_map doormen_;
   datagram_servant_map datagram_servants_;
   std::vector<char> dummy_wr_buf_;
+  network::multiplexer* backend_;
 };
 
 } // namespace io
@@ -22,8 +22,10 @@
 #include "caf/io/basp/version.hpp"
 #include "caf/io/basp/instance.hpp"
 #include "caf/io/basp/buffer_type.hpp"
+#include "caf/io/basp/fragment_scheduler.hpp"
 #include "caf/io/basp/message_type.hpp"
 #include "caf/io/basp/routing_table.hpp"
+#include "caf/io/basp/sliding_window.hpp"
 #include "caf/io/basp/connection_state.hpp"
 
 /// @defgroup BASP Binary Actor Sytem Protocol
@@ -0,0 +1,64 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <memory>
+#include <cstddef>
+
+#include "caf/atom.hpp"
+
+#include "caf/io/basp/buffer_type.hpp"
+
+namespace caf {
+namespace io {
+namespace basp {
+
+/// @addtogroup BASP
+
+/// Compresses batches of BASP messages on connections to peers that accept
+/// `compressed` messages. Each codec has a unique name that identifies it on
+/// the wire, i.e., receivers must know the codec of the sender. Users add
+/// custom codecs via `actor_system_config::add_codec_type` and select a codec
+/// via `middleman.compression`.
+class codec {
+public:
+  virtual ~codec();
+
+  /// Returns the name that identifies this codec on the wire.
+  virtual atom_value name() const = 0;
+
+  /// Appends the compressed form of `size` bytes at `data` to `out`.
+  virtual void compress(const char* data, size_t size, buffer_type& out) = 0;
+
+  /// Appends `size` bytes decompressed from `len` bytes at `data` to `out`.
+  /// Returns `false` if the input is malformed or does not decompress to
+  /// exactly `size` bytes.
+  virtual bool decompress(const char* data, size_t len, size_t size,
+                          buffer_type& out) = 0;
+};
+
+/// @relates codec
+using codec_ptr = std::unique_ptr<codec>;
+
+/// @}
+
+} // namespace basp
+} // namespace io
+} // namespace caf
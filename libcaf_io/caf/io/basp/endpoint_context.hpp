@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <map>
+#include <utility>
 #include <unordered_map>
 
 #include "caf/variant.hpp"
@@ -59,8 +61,29 @@ struct endpoint_context {
   pending_map pending;
   // track if a timeout to deliver pending messages is set
   bool did_set_timeout;
+  // remote side accepts payloads with variable-length integer encoding
+  bool varint_encoding;
+  // both sides send compact headers after their handshake
+  bool compact_headers;
+  // aliases we have assigned to node IDs when talking to the remote side
+  std::unordered_map<node_id, alias_type> out_aliases;
+  // aliases the remote side has assigned to node IDs when talking to us
+  std::unordered_map<alias_type, node_id> in_aliases;
+  // we opened this connection in addition to the direct connection
+  bool lane;
+  // partially received messages, indexed by source node and fragment ID
+  std::map<std::pair<node_id, uint64_t>, std::vector<char>> fragments;
+  // the remote side acknowledges datagrams and we retransmit lost datagrams
+  bool reliable;
+  // we send batches of messages compressed to the remote side
+  bool compression;
 };
 
+/// Returns the size of BASP headers we receive from the remote side of `ep`.
+inline size_t incoming_header_size(const endpoint_context& ep) {
+  return ep.compact_headers ? compact_header_size : header_size;
+}
+
 } // namespace basp
 } // namespace io
 } // namespace caf
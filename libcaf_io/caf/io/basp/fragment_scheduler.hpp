@@ -0,0 +1,133 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#include "caf/io/basp/header.hpp"
+#include "caf/io/basp/buffer_type.hpp"
+
+namespace caf {
+namespace io {
+namespace basp {
+
+/// @addtogroup BASP
+
+/// Interleaves large messages on a single connection. Transmits the content of
+/// each large message as sequence of `fragment` messages and picks the next
+/// frame via deficit round robin over flows, i.e., each flow receives a share
+/// of the connection proportional to its weight regardless of message sizes.
+/// Messages of the same flow never overtake each other.
+class fragment_scheduler {
+public:
+  /// Identifies a sequence of messages that must stay in order.
+  using flow_key = uint64_t;
+
+  /// Creates a scheduler that transmits up to `fragment_size` bytes per
+  /// fragment and grants `fragment_size * weight` bytes per round to a flow.
+  explicit fragment_scheduler(size_t fragment_size);
+
+  /// Returns the maximum number of bytes per fragment.
+  inline size_t fragment_size() const {
+    return fragment_size_;
+  }
+
+  /// Queries whether no message awaits transmission.
+  inline bool empty() const {
+    return flows_.empty();
+  }
+
+  /// Returns the number of bytes that await transmission.
+  inline size_t buffered() const {
+    return buffered_;
+  }
+
+  /// Queries whether the flow `key` has messages that await transmission.
+  bool pending(flow_key key) const;
+
+  /// Enqueues the serialized message `data` for transmission as a whole.
+  void push(flow_key key, size_t weight, buffer_type data);
+
+  /// Enqueues `data` for transmission as sequence of fragments, using `hdr`
+  /// for the header of each fragment.
+  void push(flow_key key, size_t weight, buffer_type data, const header& hdr);
+
+  /// Grants each flow its quantum and calls `f(hdr, data, size)` for each
+  /// frame that fits into the quantum. Passes `nullptr` as `hdr` for messages
+  /// that were enqueued as a whole.
+  template <class F>
+  void round(F f) {
+    for (auto& x : flows_) {
+      x.deficit += fragment_size_ * x.weight;
+      while (!x.queue.empty()) {
+        auto& e = x.queue.front();
+        auto n = e.data.size() - e.offset;
+        if (e.fragmented)
+          n = std::min(n, fragment_size_);
+        if (n > x.deficit)
+          break;
+        x.deficit -= n;
+        if (e.fragmented) {
+          e.hdr.payload_len = static_cast<uint32_t>(n);
+          f(&e.hdr, e.data.data() + e.offset, n);
+        } else {
+          f(static_cast<header*>(nullptr), e.data.data(), n);
+        }
+        e.offset += n;
+        buffered_ -= n;
+        if (e.offset == e.data.size())
+          x.queue.pop_front();
+      }
+    }
+    auto is_idle = [](const flow& x) { return x.queue.empty(); };
+    flows_.erase(std::remove_if(flows_.begin(), flows_.end(), is_idle),
+                 flows_.end());
+  }
+
+private:
+  struct entry {
+    buffer_type data;
+    size_t offset;
+    bool fragmented;
+    header hdr;
+  };
+
+  struct flow {
+    flow_key key;
+    size_t weight;
+    size_t deficit;
+    std::deque<entry> queue;
+  };
+
+  flow& get_flow(flow_key key, size_t weight);
+
+  size_t fragment_size_;
+  size_t buffered_;
+  std::vector<flow> flows_;
+};
+
+/// @}
+
+} // namespace basp
+} // namespace io
+} // namespace caf
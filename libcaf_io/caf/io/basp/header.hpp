@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <limits>
 #include <string>
 #include <cstdint>
 
@@ -38,6 +39,16 @@ namespace basp {
 /// Sequence number type for BASP headers.
 using sequence_type = uint16_t;
 
+/// Connection-local alias for node IDs in compact BASP headers.
+using alias_type = uint32_t;
+
+/// Refers to the node on the other end of a connection, i.e., to the sending
+/// node in source fields and to the receiving node in destination fields.
+constexpr alias_type endpoint_alias = 0;
+
+/// Refers to an invalid node ID.
+constexpr alias_type none_alias = std::numeric_limits<alias_type>::max();
+
 /// The header of a Binary Actor System Protocol (BASP) message.
 /// A BASP header consists of a routing part, i.e., source and
 /// destination, as well as an operation and operation data. Several
@@ -93,6 +104,23 @@ struct header {
   /// Identifies a receiver by name rather than ID.
   static const uint8_t named_receiver_flag = 0x01;
 
+  /// Signals support for variable-length integer encoding in handshakes.
+  /// Marks payloads using variable-length integer encoding otherwise.
+  static const uint8_t varint_flag = 0x02;
+
+  /// Signals support for compact headers in handshakes.
+  static const uint8_t compact_header_flag = 0x04;
+
+  /// Marks the client handshake on an additional connection to a node that
+  /// already has a direct connection to us.
+  static const uint8_t lane_flag = 0x08;
+
+  /// Signals support for acknowledged datagrams in handshakes.
+  static const uint8_t reliable_flag = 0x10;
+
+  /// Signals support for `compressed` messages in handshakes.
+  static const uint8_t compression_flag = 0x20;
+
   /// Queries whether this header has the given flag.
   inline bool has(uint8_t flag) const {
     return (flags & flag) != 0;
@@ -132,6 +160,12 @@ inline bool is_heartbeat(const header& hdr) {
   return hdr.operation == message_type::heartbeat;
 }
 
+/// Checks whether the payload of given header uses variable-length integer
+/// encoding. Handshakes always use fixed-width integers in their payload.
+inline bool uses_varint_encoding(const header& hdr) {
+  return !is_handshake(hdr) && hdr.has(header::varint_flag);
+}
+
 /// Checks whether given BASP header is valid.
 /// @relates header
 bool valid(const header& hdr);
@@ -143,6 +177,18 @@ constexpr size_t header_size = node_id::serialized_size * 2
                                + sizeof(uint64_t)
                                + sizeof(sequence_type);
 
+/// Size of a BASP header in compact form, i.e., with source and destination
+/// node replaced by connection-local aliases.
+constexpr size_t compact_header_size = sizeof(uint8_t) * 2
+                                       + sizeof(sequence_type)
+                                       + sizeof(uint32_t)
+                                       + sizeof(uint64_t)
+                                       + sizeof(alias_type) * 2
+                                       + sizeof(actor_id) * 2;
+
+/// Position of the payload length in both header forms.
+constexpr size_t payload_len_offset = sizeof(uint8_t) * 4;
+
 /// @}
 
 } // namespace basp
@@ -21,19 +21,23 @@
 #include <limits>
 
 #include "caf/error.hpp"
+#include "caf/flow_gate.hpp"
 #include "caf/variant.hpp"
 #include "caf/actor_system_config.hpp"
 #include "caf/binary_deserializer.hpp"
+#include "caf/streambuf.hpp"
 
 #include "caf/io/hook.hpp"
 #include "caf/io/middleman.hpp"
 
+#include "caf/io/basp/codec.hpp"
 #include "caf/io/basp/header.hpp"
 #include "caf/io/basp/buffer_type.hpp"
 #include "caf/io/basp/message_type.hpp"
 #include "caf/io/basp/routing_table.hpp"
 #include "caf/io/basp/connection_state.hpp"
 #include "caf/io/basp/endpoint_context.hpp"
+#include "caf/io/basp/fragment_scheduler.hpp"
 
 namespace caf {
 namespace io {
@@ -82,6 +86,22 @@ public:
                          std::vector<strong_actor_ptr>& forwarding_stack,
                          message& msg) = 0;
 
+    /// Called for each `dispatch_message` before deserializing its content,
+    /// i.e., the `len` bytes at `content`. Returns `true` if the callee
+    /// delivers the message after deserializing it asynchronously, `false`
+    /// if the instance must deserialize and deliver the message itself.
+    virtual bool deliver_later(const endpoint_handle& hdl, const header& hdr,
+                               atom_value dest_name,
+                               std::vector<strong_actor_ptr>& forwarding_stack,
+                               const char* content, size_t len) = 0;
+
+    /// Enqueues a message that requires no deserialization after all messages
+    /// from `hdl` still awaiting asynchronous deserialization. Returns `false`
+    /// if no such message exists, in which case the instance handles `hdr`
+    /// immediately.
+    virtual bool enqueue_ordered(const endpoint_handle& hdl, const header& hdr,
+                                 const buffer_type& payload) = 0;
+
     /// Called whenever BASP learns the ID of a remote node
     /// to which it does not have a direct connection.
     virtual void learned_new_node_directly(const node_id& nid,
@@ -157,6 +177,14 @@ public:
     /// Flushes the underlying write buffer of `hdl`.
     virtual void flush(connection_handle hdl) = 0;
 
+    /// Returns the context for `hdl` or `nullptr` if no context exists.
+    virtual endpoint_context* find_context(const endpoint_handle& hdl) = 0;
+
+    /// Called if the remote side of the reliable endpoint `ep` acknowledged
+    /// datagrams with the `ack` message `hdr`.
+    virtual void handle_ack(execution_unit* ctx, endpoint_context& ep,
+                            const header& hdr) = 0;
+
   protected:
     proxy_registry namespace_;
   };
@@ -168,19 +196,56 @@ public:
   /// Describes a callback function object for `remove_published_actor`.
   using removed_published_actor = callback<const strong_actor_ptr&, uint16_t>;
 
+  /// Identifies a connection or an endpoint.
+  using endpoint_handle = routing_table::endpoint_handle;
+
   instance(abstract_broker* parent, callee& lstnr);
 
+  ~instance();
+
   /// Handles received data and returns a config for receiving the
   /// next data or `none` if an error occured.
   connection_state handle(execution_unit* ctx,
                           new_data_msg& dm, header& hdr, bool is_payload);
 
+  /// Handles a batch of complete BASP messages, i.e., data received with
+  /// `receive_policy::framed` after the handshake. Uses `hdr` for storing
+  /// the header of each message.
+  connection_state handle_frames(execution_unit* ctx,
+                                 new_data_msg& dm, header& hdr);
+
   /// Handles a received datagram.
   bool handle(execution_unit* ctx, new_datagram_msg& dm, endpoint_context& ep);
 
   /// Sends heartbeat messages to all valid nodes those are directly connected.
   void handle_heartbeat(execution_unit* ctx);
 
+  /// Transmits the next fragments for `hdl` once the connection has no more
+  /// than one fragment of `remaining` bytes left to write.
+  void handle_data_transferred(execution_unit* ctx, connection_handle hdl,
+                               size_t remaining);
+
+  /// Discards all fragments that still await transmission via `hdl`.
+  void drop_fragments(const connection_handle& hdl);
+
+  /// Stops tracking unsent bytes of `hdl`, opening the flow gate of its peer
+  /// if no other connection to the peer is congested.
+  void drop_flow(const connection_handle& hdl);
+
+  /// Returns the flow gate for proxies of `nid` or `nullptr` if flow control
+  /// is disabled, i.e., if `middleman.high-watermark` is 0.
+  flow_gate_ptr gate(const node_id& nid);
+
+  /// Returns the number of bytes that await transmission on all direct
+  /// connections to `nid`.
+  size_t buffered_bytes(const node_id& nid) const;
+
+  /// Moves all messages in `batch` to the send buffer `out` of `hdl`. Writes
+  /// a single `compressed` message instead if `batch` has at least
+  /// `middleman.compression-threshold` bytes and compression shrinks it.
+  void write_batch(execution_unit* ctx, const connection_handle& hdl,
+                   buffer_type& batch, buffer_type& out);
+
   /// Returns a route to `target` or `none` on error.
   optional<routing_table::route> lookup(const node_id& target);
 
@@ -245,6 +310,11 @@ public:
   static void write(execution_unit* ctx, buffer_type& buf, header& hdr,
                     payload_writer* pw = nullptr);
 
+  /// Writes a header followed by its payload to the send buffer of `hdl`.
+  /// Uses compact headers if both sides agreed on them during the handshake.
+  void write(execution_unit* ctx, const endpoint_handle& hdl, header& hdr,
+             payload_writer* pw = nullptr);
+
   /// Writes the server handshake containing the information of the
   /// actor published at `port` to `buf`. If `port == none` or
   /// if no actor is published at this port then a standard handshake is
@@ -261,30 +331,59 @@ public:
                                      const std::string& app_identifier,
                                      uint16_t sequence_number = 0);
 
-  /// Writes the client handshake to `buf`.
+  /// Writes the client handshake to `buf`. Sets `header::lane_flag` if
+  /// `lane` is `true`.
   void write_client_handshake(execution_unit* ctx,
                               buffer_type& buf, const node_id& remote_side,
-                              uint16_t sequence_number = 0);
+                              uint16_t sequence_number = 0, bool lane = false);
 
-  /// Writes an `announce_proxy` to `buf`.
-  void write_announce_proxy(execution_unit* ctx, buffer_type& buf,
+  /// Writes an `announce_proxy` to the send buffer of `hdl`.
+  void write_announce_proxy(execution_unit* ctx, const endpoint_handle& hdl,
                             const node_id& dest_node, actor_id aid,
                             uint16_t sequence_number = 0);
 
-  /// Writes a `kill_proxy` to `buf`.
-  void write_kill_proxy(execution_unit* ctx, buffer_type& buf,
+  /// Writes a `kill_proxy` to the send buffer of `hdl`.
+  void write_kill_proxy(execution_unit* ctx, const endpoint_handle& hdl,
                         const node_id& dest_node, actor_id aid,
                         const error& rsn, uint16_t sequence_number = 0);
 
-  /// Writes a `heartbeat` to `buf`.
-  void write_heartbeat(execution_unit* ctx,
-                       buffer_type& buf, const node_id& remote_side,
+  /// Writes a `heartbeat` to the send buffer of `hdl`.
+  void write_heartbeat(execution_unit* ctx, const endpoint_handle& hdl,
+                       const node_id& remote_side,
                        uint16_t sequence_number = 0);
 
+  /// Writes an `ack` to `buf` that acknowledges all datagrams `ep` received
+  /// from `remote_side` so far.
+  void write_ack(execution_unit* ctx, buffer_type& buf,
+                 const endpoint_context& ep, const node_id& remote_side);
+
   inline const node_id& this_node() const {
     return this_node_;
   }
 
+  /// Returns whether this instance offers variable-length integer encoding
+  /// to its peers.
+  inline bool varint_encoding() const {
+    return varint_encoding_;
+  }
+
+  /// Returns whether this instance offers compact headers to its peers.
+  inline bool compact_headers() const {
+    return compact_headers_;
+  }
+
+  /// Returns whether this instance offers acknowledged datagrams to its
+  /// peers.
+  inline bool reliable_datagrams() const {
+    return reliable_datagrams_;
+  }
+
+  /// Returns the codec for compressing messages to peers or `nullptr` if
+  /// compression is disabled.
+  inline codec* compression() const {
+    return codec_;
+  }
+
   /// Invokes the callback(s) associated with given event.
   template <hook::event_type Event, typename... Ts>
   void notify(Ts&&... xs) {
@@ -334,6 +433,20 @@ public:
           callee_.finalize_handshake(hdr.source_node, aid, sigs);
           return false;
         }
+        // keep additional connections we opened to a directly connected node
+        if (tcp_based && tbl_.lookup_direct(hdr.source_node)) {
+          auto lane_ep = callee_.find_context(hdl);
+          if (lane_ep != nullptr && lane_ep->lane) {
+            CAF_LOG_INFO("new lane:" << CAF_ARG(hdr.source_node));
+            tbl_.add_lane(hdl, hdr.source_node);
+            write_client_handshake(ctx, callee_.get_buffer(hdl),
+                                   hdr.source_node, 0, true);
+            negotiate(hdl, hdr);
+            callee_.finalize_handshake(hdr.source_node, aid, sigs);
+            callee_.flush(hdl);
+            break;
+          }
+        }
         // close this connection if we already have a direct connection
         if (tbl_.lookup_direct(hdr.source_node)) {
           CAF_LOG_INFO("close connection since we already have a "
@@ -356,6 +469,9 @@ public:
           write_client_handshake(ctx, callee_.get_buffer(ch),
                                  hdr.source_node);
         }
+        // Our client handshake always goes out uncompressed, since the server
+        // did not see our capabilities yet.
+        negotiate(hdl, hdr);
         callee_.learned_new_node_directly(hdr.source_node, was_indirect);
         callee_.finalize_handshake(hdr.source_node, aid, sigs);
         flush(*path);
@@ -381,6 +497,12 @@ public:
         }
         if (tcp_based) {
           if (tbl_.lookup_direct(hdr.source_node)) {
+            if (hdr.has(header::lane_flag) && tbl_.lookup_direct(hdl) == none) {
+              CAF_LOG_INFO("new lane:" << CAF_ARG(hdr.source_node));
+              tbl_.add_lane(hdl, hdr.source_node);
+              negotiate(hdl, hdr);
+              break;
+            }
             CAF_LOG_INFO("received second client handshake:"
                          << CAF_ARG(hdr.source_node));
             break;
@@ -388,6 +510,7 @@ public:
           // add direct route to this node and remove any indirect entry
           CAF_LOG_INFO("new direct connection:" << CAF_ARG(hdr.source_node));
           tbl_.add_direct(hdl, hdr.source_node);
+          negotiate(hdl, hdr);
           auto was_indirect = tbl_.erase_indirect(hdr.source_node);
           callee_.learned_new_node_directly(hdr.source_node, was_indirect);
         } else {
@@ -397,6 +520,7 @@ public:
             // add direct route to this node and remove any indirect entry
             CAF_LOG_INFO("new direct connection:" << CAF_ARG(hdr.source_node));
             tbl_.add_direct(hdl, hdr.source_node);
+            negotiate(hdl, hdr);
           }
           uint16_t seq = (ep && ep->requires_ordering) ? ep->seq_outgoing++ : 0;
           write_server_handshake(ctx,
@@ -422,7 +546,9 @@ public:
             && !tbl_.lookup_direct(hdr.source_node)
             && tbl_.add_indirect(last_hop, hdr.source_node))
           callee_.learned_new_node_indirectly(hdr.source_node);
-        binary_deserializer bd{ctx, *payload};
+        charbuf buf{payload->data(), payload->size()};
+        stream_deserializer<charbuf&> bd{ctx, buf};
+        bd.varint_encoding(uses_varint_encoding(hdr));
         auto receiver_name = static_cast<atom_value>(0);
         std::vector<strong_actor_ptr> forwarding_stack;
         message msg;
@@ -431,7 +557,15 @@ public:
           if (e)
             return false;
         }
-        auto e = bd(forwarding_stack, msg);
+        auto e = bd(forwarding_stack);
+        if (e)
+          return false;
+        auto len = static_cast<size_t>(buf.in_avail());
+        if (callee_.deliver_later(hdl, hdr, receiver_name, forwarding_stack,
+                                  payload->data() + (payload->size() - len),
+                                  len))
+          break;
+        e = bd(msg);
         if (e)
           return false;
         CAF_LOG_DEBUG(CAF_ARG(forwarding_stack) << CAF_ARG(msg));
@@ -451,7 +585,10 @@ public:
       case message_type::kill_proxy: {
         if (!payload_valid())
           return false;
+        if (callee_.enqueue_ordered(hdl, hdr, *payload))
+          break;
         binary_deserializer bd{ctx, *payload};
+        bd.varint_encoding(uses_varint_encoding(hdr));
         error fail_state;
         auto e = bd(fail_state);
         if (e)
@@ -465,6 +602,48 @@ public:
         callee_.handle_heartbeat(hdr.source_node);
         break;
       }
+      case message_type::fragment: {
+        auto ep_ptr = callee_.find_context(hdl);
+        if (!payload_valid() || ep_ptr == nullptr)
+          return false;
+        auto i = ep_ptr->fragments.emplace(
+          std::make_pair(hdr.source_node, hdr.operation_data),
+          std::vector<char>{}).first;
+        auto& buf = i->second;
+        buf.insert(buf.end(), payload->begin(), payload->end());
+        if (buf.size() < header_size)
+          break;
+        header original;
+        binary_deserializer bd{ctx, buf.data(), header_size};
+        if (bd(original) || !valid(original)
+            || original.operation != message_type::dispatch_message
+            || buf.size() > header_size + original.payload_len) {
+          CAF_LOG_WARNING("received invalid fragment:" << CAF_ARG(hdr));
+          ep_ptr->fragments.erase(i);
+          return false;
+        }
+        if (buf.size() < header_size + original.payload_len)
+          break;
+        auto content = std::move(buf);
+        ep_ptr->fragments.erase(i);
+        content.erase(content.begin(), content.begin() + header_size);
+        return handle(ctx, hdl, original, &content, tcp_based, ep, port);
+      }
+      case message_type::node_alias: {
+        auto ep = callee_.find_context(hdl);
+        if (!payload_valid() || ep == nullptr || !ep->compact_headers)
+          return false;
+        binary_deserializer bd{ctx, *payload};
+        node_id nid;
+        auto e = bd(nid);
+        if (e || nid == none)
+          return false;
+        CAF_LOG_DEBUG("received alias:" << CAF_ARG(hdr.operation_data)
+                      << CAF_ARG(nid));
+        auto alias = static_cast<alias_type>(hdr.operation_data);
+        ep->in_aliases[alias] = std::move(nid);
+        break;
+      }
       default:
         CAF_LOG_ERROR("invalid operation");
         return false;
@@ -473,10 +652,97 @@ public:
   }
 
 private:
+  /// Stores the capabilities the remote side announced in its handshake `hdr`.
+  void negotiate(const endpoint_handle& hdl, const header& hdr);
+
+  /// Returns the flags for the handshakes of this instance.
+  uint8_t handshake_flags() const;
+
+  /// Returns the payload flags for sending a message to `dest` via `r`.
+  uint8_t payload_flags(const routing_table::route& r, const node_id& dest);
+
+  /// Returns the alias for `nid` on the connection `hdl`, announcing a new
+  /// alias to the remote side first if necessary.
+  alias_type make_alias(execution_unit* ctx, const endpoint_handle& hdl,
+                        endpoint_context& ep, const node_id& nid,
+                        const node_id& endpoint);
+
+  /// Handles a single BASP message received via `hdl`.
+  connection_state handle_message(execution_unit* ctx,
+                                  const connection_handle& hdl, header& hdr,
+                                  std::vector<char>* payload);
+
+  /// Handles all complete BASP messages in `[first, last)`.
+  connection_state handle_frames(execution_unit* ctx,
+                                 const connection_handle& hdl,
+                                 char* first, char* last, header& hdr);
+
+  /// Decompresses the batch of messages in `payload` and handles them.
+  connection_state handle_compressed(execution_unit* ctx,
+                                     const connection_handle& hdl,
+                                     const header& hdr,
+                                     std::vector<char>* payload);
+
+  /// Removes the direct connection `hdl` after an error and returns
+  /// `close_connection`.
+  connection_state drop(const connection_handle& hdl);
+
+  /// Reads a header in the format negotiated for `hdl` from `source`.
+  bool read_header(deserializer& source, const connection_handle& hdl,
+                   header& hdr);
+
+  /// Reads a compact header from `source`, resolving aliases via `ep`.
+  bool read_compact_header(deserializer& source, const endpoint_handle& hdl,
+                           endpoint_context& ep, header& hdr);
+
+  /// Moves the message written to `buf` at `pos` to the fragment scheduler
+  /// of `hdl` if it is too large or if it must queue up behind earlier
+  /// messages of its flow. Returns whether the message was moved.
+  bool schedule(execution_unit* ctx, const connection_handle& hdl,
+                header& hdr, buffer_type& buf, size_t pos);
+
+  /// Writes the next round of frames for `hdl` to its send buffer.
+  void write_fragments(execution_unit* ctx, const connection_handle& hdl,
+                       fragment_scheduler& sched);
+
+  /// Unsent bytes of a direct connection.
+  struct flow_state {
+    node_id peer;
+    size_t bytes;
+    bool congested;
+  };
+
+  /// Adds `n` bytes written to the send buffer of `hdl` to its flow state.
+  void add_written(const connection_handle& hdl, size_t n);
+
+  /// Returns the unsent bytes of `hdl`, including queued fragments.
+  size_t buffered_bytes(const connection_handle& hdl,
+                        const flow_state& st) const;
+
+  /// Closes or opens the flow gate of `st.peer` based on the watermarks.
+  void check_watermarks(const connection_handle& hdl, flow_state& st);
+
+  /// Returns whether any direct connection to `nid` is congested.
+  bool congested(const node_id& nid) const;
+
   routing_table tbl_;
   published_actor_map published_actors_;
   node_id this_node_;
   callee& callee_;
+  bool varint_encoding_;
+  bool compact_headers_;
+  bool reliable_datagrams_;
+  std::vector<codec_ptr> codecs_;
+  codec* codec_;
+  size_t compression_threshold_;
+  size_t fragment_size_;
+  uint64_t next_fragment_id_;
+  std::unordered_map<connection_handle, fragment_scheduler> fragments_;
+  size_t high_watermark_;
+  size_t low_watermark_;
+  flow_gate::mode backpressure_;
+  std::unordered_map<connection_handle, flow_state> flows_;
+  std::unordered_map<node_id, flow_gate_ptr> gates_;
 };
 
 /// @}
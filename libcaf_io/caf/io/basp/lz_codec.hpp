@@ -0,0 +1,70 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "caf/io/basp/codec.hpp"
+
+namespace caf {
+namespace io {
+namespace basp {
+
+/// @addtogroup BASP
+
+/// Fast LZ77-style codec that favors speed over compression ratio. Encodes
+/// its input as sequences of literals followed by a back reference into the
+/// previous 64 KB, finding matches via a single hash table lookup.
+///
+/// Each sequence starts with a token that stores the number of literals in
+/// its upper and the match length minus 4 in its lower four bits. Values of
+/// 15 continue with additional bytes that add up to the actual value, each
+/// byte of 255 adding another byte. The literals follow the token, followed
+/// by the match offset as 16-bit little endian integer and the additional
+/// bytes for the match length. The last sequence has no match.
+class lz_codec : public codec {
+public:
+  /// Shortest sequence of bytes the codec encodes as back reference.
+  static constexpr size_t min_match = 4;
+
+  /// Maximum distance of back references.
+  static constexpr size_t max_offset = 65535;
+
+  lz_codec();
+
+  atom_value name() const override;
+
+  void compress(const char* data, size_t size, buffer_type& out) override;
+
+  bool decompress(const char* data, size_t len, size_t size,
+                  buffer_type& out) override;
+
+private:
+  static constexpr size_t hash_bits = 12;
+
+  std::vector<uint32_t> table_;
+};
+
+/// @}
+
+} // namespace basp
+} // namespace io
+} // namespace caf
@@ -0,0 +1,103 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "caf/actor_control_block.hpp"
+#include "caf/allowed_unsafe_message_type.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/ref_counted.hpp"
+#include "caf/resumable.hpp"
+#include "caf/weak_intrusive_ptr.hpp"
+
+#include "caf/io/basp/buffer_type.hpp"
+#include "caf/io/basp/header.hpp"
+
+namespace caf {
+namespace io {
+namespace basp {
+
+/// Deserializes the content of inbound messages for a single connection on
+/// scheduler workers. Delivers all messages in the order of their arrival.
+/// Messages that require the broker, e.g., because they contain handles to
+/// remote actors, are handed back to the broker via `parked()`.
+class message_strand : public resumable, public ref_counted {
+public:
+  /// Stores a message from the network with an undeserialized content.
+  struct job {
+    /// Header as received from the network.
+    header hdr;
+    /// Sender of the message, resolved by the broker.
+    strong_actor_ptr src;
+    /// Receiver of the message, resolved by the broker.
+    strong_actor_ptr dest;
+    /// Forwarding stack of the message, deserialized by the broker.
+    std::vector<strong_actor_ptr> stages;
+    /// Serialized content of the message.
+    buffer_type payload;
+  };
+
+  message_strand(actor_system& sys, strong_actor_ptr broker);
+
+  ~message_strand() override;
+
+  /// Enqueues a new job and schedules this strand if necessary.
+  void push(job x);
+
+  /// Returns whether this strand has neither pending nor parked jobs.
+  bool idle();
+
+  /// Returns the job currently waiting for the broker.
+  inline job& parked() {
+    return parked_;
+  }
+
+  /// Continues processing after the broker has handled the parked job.
+  void unpark();
+
+  subtype_t subtype() const override;
+
+  resume_result resume(execution_unit* ctx, size_t max_throughput) override;
+
+  void intrusive_ptr_add_ref_impl() override;
+
+  void intrusive_ptr_release_impl() override;
+
+private:
+  void schedule();
+
+  actor_system& system_;
+  weak_actor_ptr broker_;
+  std::mutex mtx_;
+  std::deque<job> jobs_;
+  bool scheduled_;
+  job parked_;
+};
+
+/// @relates message_strand
+using message_strand_ptr = intrusive_ptr<message_strand>;
+
+} // namespace basp
+} // namespace io
+} // namespace caf
+
+CAF_ALLOW_UNSAFE_MESSAGE_TYPE(caf::io::basp::message_strand_ptr)
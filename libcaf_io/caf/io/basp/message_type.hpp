@@ -67,6 +67,25 @@ enum class message_type : uint8_t {
   ///
   /// ![](heartbeat.png)
   heartbeat = 0x05,
+
+  /// Assigns the connection-local alias in `operation_data` to the node ID in
+  /// the payload. Only used on connections with compact headers.
+  node_alias = 0x06,
+
+  /// Transmits a part of a large message. The payloads of all fragments with
+  /// the same `source_node` and `operation_data` form the original header,
+  /// serialized without compact encoding, followed by its payload.
+  fragment = 0x07,
+
+  /// Acknowledges datagrams on reliable datagram endpoints. The
+  /// `sequence_number` denotes the next expected datagram and bit `i` in
+  /// `operation_data` acknowledges datagram `sequence_number + 1 + i`.
+  ack = 0x08,
+
+  /// Transmits a batch of messages, compressed with the codec named by
+  /// `operation_data`. The payload starts with the size of the decompressed
+  /// batch as 32-bit integer.
+  compressed = 0x09,
 };
 
 /// @relates message_type
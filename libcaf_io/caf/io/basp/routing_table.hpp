@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <vector>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -70,6 +71,10 @@ public:
   /// Returns a route to `target` or `none` on error.
   optional<route> lookup(const node_id& target);
 
+  /// Returns a route to `target` that uses one of the lanes to the next hop,
+  /// selected by `key`, or `lookup(target)` if the next hop has no lanes.
+  optional<route> lookup(const node_id& target, size_t key);
+
   /// Returns the ID of the peer connected via `hdl` or
   /// `none` if `hdl` is unknown.
   node_id lookup_direct(const endpoint_handle& hdl) const;
@@ -86,6 +91,17 @@ public:
   /// @pre `hdl != invalid_connection_handle && nid != none`
   void add_direct(const endpoint_handle& hdl, const node_id& nid);
 
+  /// Adds `hdl` as lane to `nid`, i.e., as connection in addition to the
+  /// direct connection for distributing messages across multiple connections.
+  /// @pre `lookup_direct(nid) != none`
+  void add_lane(const endpoint_handle& hdl, const node_id& nid);
+
+  /// Returns all lanes to `nid`.
+  std::vector<endpoint_handle> lanes(const node_id& nid) const;
+
+  /// Queries whether `hdl` is a lane rather than a direct connection.
+  bool is_lane(const endpoint_handle& hdl) const;
+
   /// Adds a new indirect route to the table.
   bool add_indirect(const node_id& hop, const node_id& dest);
 
@@ -95,6 +111,8 @@ public:
   /// Removes a direct connection and calls `cb` for any node
   /// that became unreachable as a result of this operation,
   /// including the node that is assigned as direct path for `hdl`.
+  /// Removing a lane leaves its node reachable, whereas removing the direct
+  /// connection to a node also removes all lanes to that node.
   void erase_direct(const endpoint_handle& hdl, erase_callback& cb);
 
   /// Removes any entry for indirect connection to `dest` and returns
@@ -133,6 +151,7 @@ public:
   abstract_broker* parent_;
   std::unordered_map<endpoint_handle, node_id> direct_by_hdl_;
   std::unordered_map<node_id, endpoint_handle> direct_by_nid_;
+  std::unordered_map<node_id, std::vector<endpoint_handle>> lanes_;
   indirect_entries indirect_;
   indirect_entries blacklist_;
 };
@@ -0,0 +1,195 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#include "caf/optional.hpp"
+
+#include "caf/io/basp/buffer_type.hpp"
+#include "caf/io/basp/header.hpp"
+
+namespace caf {
+namespace io {
+namespace basp {
+
+/// @addtogroup BASP
+
+/// Retransmits datagrams until the receiver acknowledges them. Receivers
+/// acknowledge the next expected sequence number plus a bitmap of the
+/// `max_window` datagrams following it (selective acknowledgements).
+/// Datagrams go out only while the number of datagrams in flight stays below
+/// a congestion window that grows with each acknowledged datagram (slow
+/// start, then additive increase) and shrinks on losses. Retransmission
+/// timeouts follow the round-trip time estimation from RFC 6298.
+class sliding_window {
+public:
+  using clock_type = std::chrono::steady_clock;
+
+  using time_point = clock_type::time_point;
+
+  using duration_type = clock_type::duration;
+
+  /// Maximum number of datagrams in flight, limited by the size of the
+  /// bitmap for selective acknowledgements.
+  static constexpr size_t max_window = 64;
+
+  /// Number of later datagrams a receiver acknowledges before the sender
+  /// retransmits a missing datagram without waiting for the timeout.
+  static constexpr size_t dup_threshold = 3;
+
+  /// Congestion window of a new window or after a timeout.
+  static constexpr size_t initial_cwnd = 4;
+
+  /// Creates a window that has at most `window_size` datagrams in flight.
+  explicit sliding_window(size_t window_size = max_window);
+
+  /// Returns the current congestion window in datagrams.
+  inline size_t cwnd() const {
+    return cwnd_;
+  }
+
+  /// Returns the number of transmitted datagrams that still await an
+  /// acknowledgement or precede such a datagram.
+  inline size_t in_flight() const {
+    return sent_;
+  }
+
+  /// Returns the number of datagrams that await their first transmission.
+  inline size_t backlog() const {
+    return entries_.size() - sent_;
+  }
+
+  /// Queries whether all datagrams were acknowledged.
+  inline bool empty() const {
+    return entries_.empty();
+  }
+
+  /// Returns the smoothed round-trip time.
+  inline duration_type srtt() const {
+    return srtt_;
+  }
+
+  /// Returns the current retransmission timeout.
+  inline duration_type rto() const {
+    return rto_;
+  }
+
+  /// Returns how many datagrams this window has transmitted more than once.
+  inline uint64_t retransmissions() const {
+    return retransmissions_;
+  }
+
+  /// Returns when the oldest unacknowledged datagram times out or `none` if
+  /// no datagram awaits an acknowledgement.
+  optional<time_point> deadline() const;
+
+  /// Enqueues the datagram `buf` with the sequence number `seq` and calls
+  /// `f(buf)` for each datagram the congestion window admits.
+  template <class F>
+  void push(sequence_type seq, buffer_type buf, time_point now, F f) {
+    entries_.emplace_back(entry{seq, std::move(buf), now, false, false, false});
+    transmit(now, f);
+  }
+
+  /// Processes an acknowledgement for all datagrams before `next` plus all
+  /// datagrams `next + 1 + i` with bit `i` set in `sack`, then calls `f(buf)`
+  /// for each datagram to (re)transmit.
+  template <class F>
+  void ack(sequence_type next, uint64_t sack, time_point now, F f) {
+    handle_ack(next, sack, now);
+    transmit(now, f);
+  }
+
+  /// Calls `f(buf)` for each datagram that timed out at `now` as well as for
+  /// each datagram the congestion window admits afterwards.
+  template <class F>
+  void timeout(time_point now, F f) {
+    handle_timeout(now);
+    transmit(now, f);
+  }
+
+private:
+  struct entry {
+    sequence_type seq;
+    buffer_type buf;
+    time_point sent;
+    bool acked;
+    bool retransmitted;
+    bool resend;
+  };
+
+  template <class F>
+  void transmit(time_point now, F& f) {
+    for (size_t i = 0; i < sent_; ++i) {
+      auto& e = entries_[i];
+      if (e.resend) {
+        e.resend = false;
+        e.retransmitted = true;
+        e.sent = now;
+        ++retransmissions_;
+        f(e.buf);
+      }
+    }
+    auto limit = std::min(cwnd_, window_size_);
+    while (sent_ < entries_.size() && sent_ < limit) {
+      auto& e = entries_[sent_++];
+      e.sent = now;
+      f(e.buf);
+    }
+  }
+
+  void handle_ack(sequence_type next, uint64_t sack, time_point now);
+
+  void handle_timeout(time_point now);
+
+  // Marks `e` as acknowledged and returns whether it was unacknowledged.
+  bool acknowledge(entry& e, time_point now);
+
+  // Updates the RTT estimation and the retransmission timeout.
+  void add_rtt_sample(duration_type rtt);
+
+  // Reduces the congestion window after a loss.
+  void enter_recovery(bool timeout);
+
+  std::deque<entry> entries_;
+  size_t sent_;
+  size_t window_size_;
+  size_t cwnd_;
+  size_t ssthresh_;
+  size_t acked_in_round_;
+  bool recovering_;
+  sequence_type recovery_seq_;
+  bool has_rtt_;
+  duration_type srtt_;
+  duration_type rttvar_;
+  duration_type rto_;
+  uint64_t retransmissions_;
+};
+
+/// @}
+
+} // namespace basp
+} // namespace io
+} // namespace caf
@@ -39,6 +39,7 @@
 #include "caf/io/typed_broker.hpp"
 
 #include "caf/io/basp/endpoint_context.hpp"
+#include "caf/io/basp/message_strand.hpp"
 
 namespace caf {
 namespace io {
@@ -79,6 +80,19 @@ struct basp_broker_state : proxy_registry::backend, basp::instance::callee {
                strong_actor_ptr dest, message_id mid,
                std::vector<strong_actor_ptr>& stages, message& msg);
 
+  // inherited from basp::instance::callee
+  bool deliver_later(const endpoint_handle& hdl, const basp::header& hdr,
+                     atom_value dest_name,
+                     std::vector<strong_actor_ptr>& stages,
+                     const char* content, size_t len) override;
+
+  // inherited from basp::instance::callee
+  bool enqueue_ordered(const endpoint_handle& hdl, const basp::header& hdr,
+                       const buffer_type& payload) override;
+
+  // handles a message that a strand could not deliver on its own
+  void deliver_parked(basp::message_strand& strand);
+
   // performs bookkeeping such as managing `spawn_servers`
   void learned_new_node(const node_id& nid);
 
@@ -128,6 +142,29 @@ struct basp_broker_state : proxy_registry::backend, basp::instance::callee {
   // inherited from basp::instance::callee
   void flush(connection_handle hdl) override;
 
+  /// Flushes all connections with coalesced writes.
+  void flush_coalesced();
+
+  /// Moves the batch of messages for `hdl` to its send buffer and flushes it.
+  void flush_batch(connection_handle hdl);
+
+  // inherited from basp::instance::callee
+  basp::endpoint_context* find_context(const endpoint_handle& hdl) override;
+
+  // inherited from basp::instance::callee
+  void handle_ack(execution_unit* ctx, basp::endpoint_context& ep,
+                  const basp::header& hdr) override;
+
+  /// Sends `buf` via the sliding window of `hdl` unless it contains an `ack`.
+  void send_reliable(datagram_handle hdl, buffer_type buf);
+
+  /// Retransmits timed out datagrams of `hdl`.
+  void retransmit(datagram_handle hdl);
+
+  /// Schedules a `retransmit_atom` for the next deadline of `hdl` unless a
+  /// timer is already pending.
+  void arm_retransmit(datagram_handle hdl);
+
   void handle_heartbeat(const node_id&) override {
     // nop
   }
@@ -136,6 +173,10 @@ struct basp_broker_state : proxy_registry::backend, basp::instance::callee {
   void set_context(connection_handle hdl);
   void set_context(datagram_handle hdl);
 
+  /// Opens additional connections to the node behind `hdl` as configured by
+  /// `middleman.connections-per-peer`.
+  void open_lanes(connection_handle hdl);
+
   /// Cleans up any state for `hdl`.
   void cleanup(connection_handle hdl);
   void cleanup(datagram_handle hdl);
@@ -183,6 +224,37 @@ struct basp_broker_state : proxy_registry::backend, basp::instance::callee {
   // timeout for delivery of pending messages of endpoints with ordering
   const std::chrono::milliseconds pending_to = std::chrono::milliseconds(100);
 
+  // maximum number of unacknowledged datagrams per reliable endpoint
+  const size_t reliable_window;
+
+  // unacknowledged datagrams of reliable endpoints
+  std::unordered_map<datagram_handle, basp::sliding_window> windows;
+
+  // reliable endpoints with a pending `retransmit_atom`
+  std::unordered_set<datagram_handle> retransmit_timers;
+
+  // minimum number of buffered bytes before flushing a connection immediately
+  // (0 disables write coalescing)
+  const size_t flush_threshold;
+
+  // maximum delay for coalesced writes (0 flushes after the current batch)
+  const timespan max_flush_delay;
+
+  // connections with coalesced writes that still need flushing
+  std::unordered_set<connection_handle> coalesced;
+
+  // messages for connections with compression that await the next flush
+  std::unordered_map<connection_handle, buffer_type> batches;
+
+  // configures whether scheduler workers deserialize inbound messages
+  const bool parallel_deserialization;
+
+  // deserializes inbound messages per connection on scheduler workers
+  std::unordered_map<connection_handle, basp::message_strand_ptr> strands;
+
+  // configures whether connections switch to framed reads after the handshake
+  const bool framed_reads;
+
   // returns the node identifier of the underlying BASP instance
   const node_id& this_node() const {
     return instance.this_node();
@@ -214,6 +286,11 @@ public:
   behavior make_behavior() override;
   proxy_registry* proxy_registry_ptr() override;
   resume_result resume(execution_unit*, size_t) override;
+
+private:
+  /// Closes all doormen for `port`, i.e., also Unix domain sockets standing
+  /// in for the TCP port. Returns whether at least one doorman was closed.
+  bool close_doormen(uint16_t port);
 };
 
 } // namespace io
@@ -53,6 +53,12 @@ behavior datagram_connection_broker(broker* self,
 
 behavior connection_helper(stateful_actor<connection_helper_state>* self,
                            actor b);
+
+/// Opens `num` additional connections to the node at `host` and `port` and
+/// sends them to the BASP broker `b` for use as lanes. Interprets `host` as
+/// path to a UNIX domain socket if it starts with a slash.
+void lane_helper(event_based_actor* self, actor b, std::string host,
+                 uint16_t port, size_t num);
 } // namespace io
 } // namespace caf
 
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <map>
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <thread>
@@ -187,6 +188,22 @@ public:
   /// Returns the IO backend used by this middleman.
   virtual network::multiplexer& backend() = 0;
 
+  /// Returns the number of multiplexers running brokers, i.e., `backend()`
+  /// plus one additional multiplexer per extra `multiplexer-threads`.
+  inline size_t backend_count() const {
+    return shards_.size() + 1;
+  }
+
+  /// Returns the pool for read and write buffers shared by all multiplexers.
+  inline network::buffer_pool& buffers() {
+    return buffers_;
+  }
+
+  /// Returns the multiplexer for the next broker, distributing brokers
+  /// round-robin over all multiplexers.
+  /// @note This member function is thread-safe.
+  network::multiplexer& next_backend();
+
   /// Invokes the callback(s) associated with given event.
   template <hook::event_type Event, typename... Ts>
   void notify(Ts&&... ts) {
@@ -211,6 +228,12 @@ public:
   ///       or an error occurred.
   strong_actor_ptr remote_lookup(atom_value name, const node_id& nid);
 
+  /// Returns the number of bytes that currently await transmission on all
+  /// direct connections to `nid`. Returns 0 for unknown nodes and if flow
+  /// control is disabled, i.e., if `middleman.high-watermark` is 0.
+  /// @note Blocks the caller until the BASP broker responded.
+  size_t buffered_bytes(const node_id& nid);
+
   /// @experimental
   template <class Handle>
   expected<Handle>
@@ -255,7 +278,7 @@ public:
             class F = std::function<void(broker*)>, class... Ts>
   typename infer_handle_from_fun<F>::type
   spawn_broker(F fun, Ts&&... xs) {
-    actor_config cfg{&backend()};
+    actor_config cfg{&next_backend()};
     return system().spawn_functor<Os>(cfg, fun, std::forward<Ts>(xs)...);
   }
 
@@ -310,6 +333,10 @@ public:
         return backend_;
       }
 
+      backend_pointer make_backend() override {
+        return backend_pointer{new Backend(&system())};
+      }
+
     private:
       Backend backend_;
     };
@@ -319,17 +346,22 @@ public:
 protected:
   middleman(actor_system& sys);
 
+  /// Creates an additional multiplexer of the same type as `backend()` or
+  /// returns `nullptr` if the backend does not support multiple threads.
+  virtual backend_pointer make_backend();
+
 private:
   template <spawn_options Os, class Impl, class F, class... Ts>
   expected<typename infer_handle_from_class<Impl>::type>
   spawn_client_impl(F fun, const std::string& host, uint16_t port, Ts&&... xs) {
-    auto eptr = backend().new_tcp_scribe(host, port);
+    auto& mpx = next_backend();
+    auto eptr = mpx.new_tcp_scribe(host, port);
     if (!eptr)
       return eptr.error();
     auto ptr = std::move(*eptr);
     CAF_ASSERT(ptr != nullptr);
     detail::init_fun_factory<Impl, F> fac;
-    actor_config cfg{&backend()};
+    actor_config cfg{&mpx};
     auto init_fun = fac(std::move(fun), ptr->hdl(), std::forward<Ts>(xs)...);
     cfg.init_fun = [ptr, init_fun](local_actor* self) mutable -> behavior {
       static_cast<abstract_broker*>(self)->add_scribe(std::move(ptr));
@@ -341,14 +373,15 @@ private:
   template <spawn_options Os, class Impl, class F, class... Ts>
   expected<typename infer_handle_from_class<Impl>::type>
   spawn_server_impl(F fun, uint16_t& port, Ts&&... xs) {
-    auto eptr = backend().new_tcp_doorman(port);
+    auto& mpx = next_backend();
+    auto eptr = mpx.new_tcp_doorman(port);
     if (!eptr)
       return eptr.error();
     auto ptr = std::move(*eptr);
     detail::init_fun_factory<Impl, F> fac;
     auto init_fun = fac(std::move(fun), std::forward<Ts>(xs)...);
     port = ptr->port();
-    actor_config cfg{&backend()};
+    actor_config cfg{&mpx};
     cfg.init_fun = [ptr, init_fun](local_actor* self) mutable -> behavior {
       static_cast<abstract_broker*>(self)->add_doorman(std::move(ptr));
       return init_fun(self);
@@ -383,10 +416,20 @@ private:
 
   // environment
   actor_system& system_;
+  // caches network buffers for all multiplexers
+  network::buffer_pool buffers_;
   // prevents backend from shutting down unless explicitly requested
   network::multiplexer::supervisor_ptr backend_supervisor_;
   // runs the backend
   std::thread thread_;
+  // additional multiplexers for brokers, each running in its own thread
+  std::vector<backend_pointer> shards_;
+  // prevents additional multiplexers from shutting down
+  std::vector<network::multiplexer::supervisor_ptr> shard_supervisors_;
+  // runs the additional multiplexers
+  std::vector<std::thread> shard_threads_;
+  // selects the multiplexer for the next broker
+  std::atomic<size_t> next_shard_;
   // keeps track of "singleton-like" brokers
   std::map<atom_value, actor> named_brokers_;
   // user-defined hooks
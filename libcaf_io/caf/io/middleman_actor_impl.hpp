@@ -74,7 +74,21 @@ protected:
   virtual expected<datagram_servant_ptr> open_udp(uint16_t port, 
                                                   const char* addr, bool reuse);
 
+  /// Tries to connect to the Unix domain socket standing in for the TCP port
+  /// `port` on this host. The default implementation calls
+  /// `system().middleman().backend().new_local_scribe(path, port)`.
+  virtual expected<scribe_ptr> connect_local(uint16_t port);
+
+  /// Tries to open a Unix domain socket standing in for the TCP port `port`.
+  /// The default implementation calls
+  /// `system().middleman().backend().new_local_doorman(path, port)`.
+  virtual expected<doorman_ptr> open_local(uint16_t port);
+
 private:
+  /// Returns the path of the Unix domain socket for `port` or an empty string
+  /// if `middleman.unix-socket-dir` is not set.
+  std::string local_socket_path(uint16_t port) const;
+
   put_res put(uint16_t port, strong_actor_ptr& whom, mpi_set& sigs,
               const char* in = nullptr, bool reuse_addr = false);
 
@@ -0,0 +1,119 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "caf/meta/type_name.hpp"
+
+namespace caf {
+namespace io {
+namespace network {
+
+/// Caches read and write buffers of network connections in power-of-two size
+/// classes. Connections release their buffers while idle and acquire a buffer
+/// again for the next I/O operation, i.e., the memory of idle connections
+/// stays bounded by the capacity of the pool while busy connections reuse
+/// buffers instead of allocating new ones.
+/// @threadsafe
+class buffer_pool {
+public:
+  /// The buffer type used by streams and datagram handlers.
+  using buffer_type = std::vector<char>;
+
+  /// Smallest size class, i.e., the pool drops buffers with less capacity.
+  static constexpr size_t min_class = 10;
+
+  /// Largest size class, i.e., the pool drops buffers with more capacity.
+  static constexpr size_t max_class = 24;
+
+  /// Number of size classes.
+  static constexpr size_t num_classes = max_class - min_class + 1;
+
+  /// Counters for evaluating the effectiveness of the pool.
+  struct statistics {
+    /// Number of buffers handed out by `acquire`.
+    uint64_t acquired = 0;
+    /// Number of `acquire` calls served from a cached buffer.
+    uint64_t reused = 0;
+    /// Number of buffers stored by `release`.
+    uint64_t released = 0;
+    /// Number of buffers `release` deallocated instead of storing them.
+    uint64_t dropped = 0;
+    /// Number of currently cached buffers.
+    size_t cached_buffers = 0;
+    /// Accumulated capacity of all currently cached buffers.
+    size_t cached_bytes = 0;
+  };
+
+  /// Creates a pool that caches up to `capacity` bytes.
+  explicit buffer_pool(size_t capacity = 0);
+
+  buffer_pool(const buffer_pool&) = delete;
+
+  buffer_pool& operator=(const buffer_pool&) = delete;
+
+  /// Returns whether the pool caches any buffers at all.
+  inline bool enabled() const {
+    return capacity_ > 0;
+  }
+
+  /// Returns the maximum number of bytes this pool caches.
+  inline size_t capacity() const {
+    return capacity_;
+  }
+
+  /// Stores an empty buffer with a capacity of at least `size` bytes in `buf`,
+  /// discarding the previous content of `buf`.
+  void acquire(buffer_type& buf, size_t size);
+
+  /// Moves `buf` into the pool or deallocates it if the pool is full, leaving
+  /// `buf` empty without any capacity in both cases.
+  void release(buffer_type& buf);
+
+  /// Deallocates all cached buffers.
+  void clear();
+
+  /// Returns a snapshot of the current statistics.
+  statistics stats() const;
+
+private:
+  using list_type = std::vector<buffer_type>;
+
+  mutable std::mutex mtx_;
+  size_t capacity_;
+  std::array<list_type, num_classes> lists_;
+  statistics stats_;
+};
+
+/// @relates buffer_pool::statistics
+template <class Inspector>
+typename Inspector::result_type inspect(Inspector& f,
+                                        buffer_pool::statistics& x) {
+  return f(meta::type_name("buffer_pool_statistics"), x.acquired, x.reused,
+           x.released, x.dropped, x.cached_buffers, x.cached_bytes);
+}
+
+} // namespace network
+} // namespace io
+} // namespace caf
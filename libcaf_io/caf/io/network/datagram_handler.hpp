@@ -69,6 +69,7 @@ public:
   inline write_buffer_type& wr_buf(datagram_handle hdl) {
     wr_offline_buf_.emplace_back();
     wr_offline_buf_.back().first = hdl;
+    acquire_wr_buf(wr_offline_buf_.back().second);
     return wr_offline_buf_.back().second;
   }
 
@@ -118,6 +119,14 @@ protected:
     auto mcr = max_consecutive_reads_;
     switch (op) {
       case io::network::operation::read: {
+        // Deliver datagrams of a previous batch first, e.g., after
+        // re-activating the handler.
+        if (!deliver_batch())
+          return;
+        if (batch_size_ > 1) {
+          read_batches(policy);
+          break;
+        }
         // Loop until an error occurs or we have nothing more to read
         // or until we have handled `mcr` reads.
         for (size_t i = 0; i < mcr; ++i) {
@@ -129,6 +138,10 @@ protected:
         break;
       }
       case io::network::operation::write: {
+        if (batch_size_ > 1) {
+          write_batch(policy);
+          break;
+        }
         size_t wb; // written bytes
         auto itr = ep_by_hdl_.find(wr_buf_.first);
         // maybe this could be an assert?
@@ -154,10 +167,79 @@ protected:
   }
 
 private:
+  /// Receives up to `batch_size_` datagrams per system call until the socket
+  /// has no more data or until we have received `max_consecutive_reads_`
+  /// datagrams.
+  template <class Policy>
+  void read_batches(Policy& policy) {
+    size_t received = 0;
+    do {
+      size_t num = 0;
+      auto res = policy.read_datagrams(num, fd(), rd_bufs_.data(),
+                                       rd_sizes_.data(), rd_senders_.data(),
+                                       batch_size_);
+      if (!res) {
+        handle_read_result(false);
+        return;
+      }
+      rd_pos_ = 0;
+      rd_count_ = num;
+      if (!deliver_batch() || num < batch_size_)
+        return;
+      received += num;
+    } while (received < max_consecutive_reads_);
+  }
+
+  /// Sends the current job together with up to `batch_size_ - 1` queued jobs
+  /// with a single system call.
+  template <class Policy>
+  void write_batch(Policy& policy) {
+    wr_batch_bufs_.clear();
+    wr_batch_eps_.clear();
+    auto add = [&](job_type& job) {
+      auto itr = ep_by_hdl_.find(job.first);
+      if (itr == ep_by_hdl_.end())
+        CAF_RAISE_ERROR("got write event for undefined endpoint");
+      auto size_as_int = static_cast<int>(job.second.size());
+      if (size_as_int > send_buffer_size_) {
+        send_buffer_size_ = size_as_int;
+        send_buffer_size(fd(), size_as_int);
+      }
+      wr_batch_bufs_.push_back(&job.second);
+      wr_batch_eps_.push_back(&itr->second);
+    };
+    add(wr_buf_);
+    for (auto i = wr_offline_buf_.begin();
+         i != wr_offline_buf_.end() && wr_batch_bufs_.size() < batch_size_;
+         ++i)
+      add(*i);
+    size_t sent = 0;
+    auto res = policy.write_datagrams(sent, fd(), wr_batch_bufs_.data(),
+                                      wr_batch_eps_.data(),
+                                      wr_batch_bufs_.size());
+    handle_write_results(res, sent);
+  }
+
   size_t max_consecutive_reads_;
 
   void prepare_next_read();
 
+  /// Passes a received datagram to the reader. Returns `false` if the reader
+  /// refused further datagrams.
+  bool deliver(read_buffer_type& buf, size_t num_bytes);
+
+  /// Passes all datagrams of the last batch to the reader that it did not
+  /// consume yet.
+  bool deliver_batch();
+
+  void handle_write_results(bool write_result, size_t num_sent);
+
+  /// Takes a buffer from the buffer pool of the multiplexer, if any.
+  void acquire_wr_buf(write_buffer_type& buf);
+
+  /// Returns a buffer to the buffer pool of the multiplexer, if any.
+  void release_wr_buf(write_buffer_type& buf);
+
   void prepare_next_write();
 
   bool handle_read_result(bool read_result);
@@ -178,6 +260,16 @@ private:
   manager_ptr reader_;
   ip_endpoint sender_;
 
+  // state for batched I/O via `read_datagrams` and `write_datagrams`
+  const size_t batch_size_;
+  std::vector<read_buffer_type> rd_bufs_;
+  std::vector<size_t> rd_sizes_;
+  std::vector<ip_endpoint> rd_senders_;
+  size_t rd_pos_;
+  size_t rd_count_;
+  std::vector<const write_buffer_type*> wr_batch_bufs_;
+  std::vector<const ip_endpoint*> wr_batch_eps_;
+
   // state for writing
   int send_buffer_size_;
   bool ack_writes_;
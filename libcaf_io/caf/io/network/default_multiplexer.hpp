@@ -126,6 +126,12 @@ public:
   expected<doorman_ptr> new_tcp_doorman(uint16_t port, const char* in,
                                         bool reuse_addr) override;
 
+  expected<scribe_ptr> new_local_scribe(const std::string& path,
+                                        uint16_t port) override;
+
+  expected<doorman_ptr> new_local_doorman(const std::string& path,
+                                          uint16_t port) override;
+
   datagram_servant_ptr new_datagram_servant(native_socket fd) override;
 
   datagram_servant_ptr
@@ -173,9 +179,9 @@ public:
   /// Run all pending events generated from calls to `add` or `del`.
   void handle_internal_events();
 
-private:
+protected:
   /// Calls `epoll`, `kqueue`, or `poll` with or without blocking.
-  bool poll_once_impl(bool block);
+  virtual bool poll_once_impl(bool block);
 
   // platform-dependent additional initialization code
   void init();
@@ -219,7 +225,8 @@ private:
     }
   }
 
-  void handle(const event& e);
+  /// Applies a registration change from `events_` to the OS-level event loop.
+  virtual void handle(const event& e);
 
   void handle_socket_event(native_socket fd, int mask, event_handler* ptr);
 
@@ -275,6 +282,13 @@ new_tcp_connection(const std::string& host, uint16_t port,
 expected<native_socket>
 new_tcp_acceptor_impl(uint16_t port, const char* addr, bool reuse_addr);
 
+/// Connects to the Unix domain socket at `path`.
+expected<native_socket> new_local_connection(const std::string& path);
+
+/// Creates a listening Unix domain socket at `path`, replacing stale socket
+/// files that no process accepts connections on.
+expected<native_socket> new_local_acceptor_impl(const std::string& path);
+
 expected<std::pair<native_socket, ip_endpoint>>
 new_remote_udp_endpoint_impl(const std::string& host, uint16_t port,
                              optional<protocol::network> preferred = none);
@@ -0,0 +1,51 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+#pragma once
+
+#include <string>
+
+#include "caf/io/network/doorman_impl.hpp"
+
+namespace caf {
+namespace io {
+namespace network {
+
+/// Doorman for a Unix domain socket that accepts connections on behalf of a
+/// TCP port. Reports the path of the socket as address and the TCP port as
+/// port. Removes the socket file on destruction.
+class local_doorman_impl : public doorman_impl {
+public:
+  local_doorman_impl(default_multiplexer& mx, native_socket sockfd,
+                     std::string path, uint16_t port);
+
+  ~local_doorman_impl() override;
+
+  bool new_connection() override;
+
+  std::string addr() const override;
+
+  uint16_t port() const override;
+
+private:
+  std::string path_;
+  uint16_t port_;
+};
+
+} // namespace network
+} // namespace io
+} // namespace caf
@@ -33,6 +33,7 @@
 #include "caf/io/connection_handle.hpp"
 
 #include "caf/io/network/protocol.hpp"
+#include "caf/io/network/buffer_pool.hpp"
 #include "caf/io/network/ip_endpoint.hpp"
 #include "caf/io/network/native_socket.hpp"
 
@@ -68,6 +69,18 @@ public:
                                                 const char* in = nullptr,
                                                 bool reuse_addr = false) = 0;
 
+  /// Tries to connect to the Unix domain socket at `path` and returns a
+  /// `scribe` reporting `port` as its remote port on success.
+  /// @threadsafe
+  virtual expected<scribe_ptr> new_local_scribe(const std::string& path,
+                                                uint16_t port);
+
+  /// Tries to create a doorman accepting connections on the Unix domain
+  /// socket at `path` on behalf of the TCP port `port`.
+  /// @warning Do not call from outside the multiplexer's event loop.
+  virtual expected<doorman_ptr> new_local_doorman(const std::string& path,
+                                                  uint16_t port);
+
   /// Creates a new `datagram_servant` from a native socket handle.
   /// @threadsafe
   virtual datagram_servant_ptr new_datagram_servant(native_socket fd) = 0;
@@ -161,10 +174,25 @@ public:
     tid_ = std::move(tid);
   }
 
+  /// Returns the pool for read and write buffers of sockets managed by this
+  /// multiplexer or `nullptr` if sockets allocate their own buffers.
+  inline buffer_pool* buffers() const {
+    return buffers_;
+  }
+
+  /// Sets the pool for read and write buffers. Must be called before
+  /// creating any socket.
+  inline void buffers(buffer_pool* ptr) {
+    buffers_ = ptr;
+  }
+
 protected:
   /// Identifies the thread this multiplexer
   /// is running in. Must be set by the subclass.
   std::thread::id tid_;
+
+  /// Points to the pool shared by all multiplexers of the middleman.
+  buffer_pool* buffers_;
 };
 
 using multiplexer_ptr = std::unique_ptr<multiplexer>;
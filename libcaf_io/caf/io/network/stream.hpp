@@ -69,6 +69,8 @@ public:
   /// @warning Must not be modified outside the IO multiplexers event loop
   ///          once the stream has been started.
   inline buffer_type& wr_buf() {
+    if (wr_offline_buf_.capacity() == 0)
+      acquire_wr_buf();
     return wr_offline_buf_;
   }
 
@@ -101,6 +103,14 @@ protected:
     CAF_LOG_TRACE(CAF_ARG(op));
     switch (op) {
       case io::network::operation::read: {
+        // Idle streams return their read buffer to the buffer pool.
+        if (rd_buf_.empty()) {
+          acquire_rd_buf();
+          prepare_next_read();
+        }
+        // Deliver pending data first, e.g., after re-activating the stream.
+        if (collected_ >= read_threshold_ && !consume_buffered())
+          return;
         // Loop until an error occurs or we have nothing more to read
         // or until we have handled `mcr` reads.
         size_t rb = 0;
@@ -121,8 +131,7 @@ protected:
       }
       case io::network::operation::write: {
         size_t wb; // Written bytes.
-        auto res = policy.write_some(wb, fd(), wr_buf_.data() + written_,
-                                     wr_buf_.size() - written_);
+        auto res = write_some(policy, wb, 0);
         handle_write_result(res, wb);
         break;
       }
@@ -133,8 +142,43 @@ protected:
   }
 
 private:
+  /// Sends the remainder of `wr_buf_` together with `wr_offline_buf_` in a
+  /// single gather write if the policy supports it.
+  template <class Policy>
+  auto write_some(Policy& policy, size_t& wb, int)
+  -> decltype(policy.write_some(wb, fd(), nullptr, 0, nullptr, 0)) {
+    if (wr_offline_buf_.empty())
+      return policy.write_some(wb, fd(), wr_buf_.data() + written_,
+                               wr_buf_.size() - written_);
+    return policy.write_some(wb, fd(), wr_buf_.data() + written_,
+                             wr_buf_.size() - written_,
+                             wr_offline_buf_.data(), wr_offline_buf_.size());
+  }
+
+  template <class Policy>
+  rw_state write_some(Policy& policy, size_t& wb, long) {
+    return policy.write_some(wb, fd(), wr_buf_.data() + written_,
+                             wr_buf_.size() - written_);
+  }
+
   void prepare_next_read();
 
+  /// Takes a read buffer from the buffer pool of the multiplexer, if any,
+  /// unless the stream already has one.
+  void acquire_rd_buf();
+
+  /// Returns the read buffer to the buffer pool of the multiplexer, if any,
+  /// unless it holds data of an incomplete read.
+  void release_rd_buf();
+
+  /// Takes a write buffer from the buffer pool of the multiplexer, if any.
+  void acquire_wr_buf();
+
+  /// Passes buffered data to the reader until the buffer no longer holds
+  /// enough data for the current receive policy. Returns `false` if the
+  /// reader refused further data.
+  bool consume_buffered();
+
   void prepare_next_write();
 
   bool handle_read_result(rw_state read_result, size_t rb);
@@ -152,6 +196,7 @@ private:
   size_t max_;
   receive_policy_flag rd_flag_;
   buffer_type rd_buf_;
+  buffer_type rd_tail_;
 
   // State for writing.
   manager_ptr writer_;
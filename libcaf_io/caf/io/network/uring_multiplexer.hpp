@@ -0,0 +1,132 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "caf/config.hpp"
+
+#include "caf/io/network/default_multiplexer.hpp"
+
+#if defined(CAF_HAS_IO_URING) && defined(CAF_EPOLL_MULTIPLEXER)
+
+#define CAF_URING_MULTIPLEXER
+
+// Forward declaration of C types.
+extern "C" {
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+} // extern "C"
+
+namespace caf {
+namespace io {
+namespace network {
+
+/// A multiplexer that waits for socket events via `io_uring` instead of
+/// `epoll`. All registration changes of one loop iteration are submitted
+/// together with waiting for the next events, i.e., each iteration costs a
+/// single `io_uring_enter` call. Scribes, doormen and datagram servants run
+/// unchanged, because this multiplexer reports readiness events just like
+/// the `default_multiplexer`.
+class uring_multiplexer : public default_multiplexer {
+public:
+  explicit uring_multiplexer(actor_system* sys);
+
+  ~uring_multiplexer() override;
+
+  /// Returns whether the kernel allows this process to create an `io_uring`.
+  static bool available();
+
+protected:
+  bool poll_once_impl(bool block) override;
+
+  void handle(const event& e) override;
+
+private:
+  /// Bookkeeping for a single socket in the ring.
+  struct registration {
+    /// Handler for the socket, points to the pipe reader for our pipe.
+    event_handler* ptr;
+    /// Events the handler is currently interested in.
+    int mask;
+    /// Distinguishes polls for re-used file descriptors.
+    uint32_t generation;
+    /// Stores whether the ring has a pending poll for this socket.
+    bool armed;
+  };
+
+  /// Encodes file descriptor and generation of `x` as user data.
+  static uint64_t user_data(native_socket fd, const registration& x);
+
+  /// Returns a free submission queue entry, flushing the queue if necessary.
+  io_uring_sqe* next_sqe();
+
+  /// Submits a one-shot poll for `fd` using the mask stored in `x`.
+  void arm(native_socket fd, registration& x);
+
+  /// Submits a request for removing the pending poll for `fd`.
+  void disarm(native_socket fd, registration& x);
+
+  /// Submits all pending entries and waits for at least `min_complete`
+  /// completions.
+  void enter(unsigned min_complete);
+
+  // -- ring state -------------------------------------------------------------
+
+  int ring_fd_;
+
+  void* sq_ptr_;
+  size_t sq_len_;
+  void* cq_ptr_;
+  size_t cq_len_;
+  io_uring_sqe* sqes_;
+  size_t sqes_len_;
+
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned* sq_mask_;
+  unsigned* sq_array_;
+  unsigned sq_entries_;
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned* cq_mask_;
+  io_uring_cqe* cqes_;
+
+  /// Number of entries written to the submission queue but not yet submitted.
+  unsigned pending_;
+
+  // -- multiplexer state ------------------------------------------------------
+
+  std::unordered_map<native_socket, registration> registrations_;
+
+  uint32_t next_generation_;
+
+  /// Sockets with completed polls that need re-arming after handling events.
+  std::vector<native_socket> fired_;
+};
+
+} // namespace network
+} // namespace io
+} // namespace caf
+
+#endif // defined(CAF_HAS_IO_URING) && defined(CAF_EPOLL_MULTIPLEXER)
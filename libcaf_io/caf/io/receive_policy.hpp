@@ -20,6 +20,7 @@
 
 #include <string>
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 
 #include "caf/config.hpp"
@@ -30,13 +31,21 @@ namespace io {
 enum class receive_policy_flag {
   at_least,
   at_most,
-  exactly
+  exactly,
+  framed
 };
 
 inline std::string to_string(receive_policy_flag x) {
-  return x == receive_policy_flag::at_least
-         ? "at_least"
-         : (x == receive_policy_flag::at_most ? "at_most" : "exactly");
+  switch (x) {
+    case receive_policy_flag::at_least:
+      return "at_least";
+    case receive_policy_flag::at_most:
+      return "at_most";
+    case receive_policy_flag::exactly:
+      return "exactly";
+    default:
+      return "framed";
+  }
 }
 
 class receive_policy {
@@ -59,6 +68,47 @@ public:
     CAF_ASSERT(num_bytes > 0);
     return {receive_policy_flag::exactly, num_bytes};
   }
+
+  /// Reads as much data as available and delivers all complete frames of a
+  /// read at once. Each frame starts with a header of `header_size` bytes
+  /// that stores the number of bytes following the header as 32-bit
+  /// unsigned integer in network byte order at `length_offset`.
+  static inline config framed(size_t header_size, size_t length_offset) {
+    CAF_ASSERT(length_offset + sizeof(uint32_t) <= header_size);
+    CAF_ASSERT(header_size <= 0xFFFF);
+    return {receive_policy_flag::framed, (header_size << 16) | length_offset};
+  }
+
+  /// Returns the header size of a `framed` configuration.
+  static inline size_t frame_header_size(const config& x) {
+    return x.second >> 16;
+  }
+
+  /// Returns the size of the frame starting at `header` for a `framed`
+  /// configuration.
+  static inline size_t frame_size(const config& x, const char* header) {
+    auto first = reinterpret_cast<const uint8_t*>(header) + (x.second & 0xFFFF);
+    auto len = (static_cast<uint32_t>(first[0]) << 24)
+               | (static_cast<uint32_t>(first[1]) << 16)
+               | (static_cast<uint32_t>(first[2]) << 8)
+               | static_cast<uint32_t>(first[3]);
+    return frame_header_size(x) + len;
+  }
+
+  /// Returns the number of bytes in `buf` that belong to complete frames for
+  /// a `framed` configuration.
+  static inline size_t complete_frames(const config& x, const char* buf,
+                                       size_t num_bytes) {
+    auto hsize = frame_header_size(x);
+    size_t result = 0;
+    while (num_bytes - result >= hsize) {
+      auto fsize = frame_size(x, buf + result);
+      if (num_bytes - result < fsize)
+        break;
+      result += fsize;
+    }
+    return result;
+  }
 };
 
 } // namespace io
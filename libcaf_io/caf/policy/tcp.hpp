@@ -42,6 +42,15 @@ struct tcp {
                                           io::network::native_socket fd,
                                           const void* buf, size_t len);
 
+  /// Writes up to `len1 + len2` bytes from `buf1` and `buf2` to `fd` using a
+  /// single gather write. Returns `true` as long as `fd` is readable and
+  /// `false` if the socket has been closed or an IO error occured. The number
+  /// of written bytes is stored in `result` (can be 0).
+  static io::network::rw_state write_some(size_t& result,
+                                          io::network::native_socket fd,
+                                          const void* buf1, size_t len1,
+                                          const void* buf2, size_t len2);
+
   /// Tries to accept a new connection from `fd`. On success,
   /// the new connection is stored in `result`. Returns true
   /// as long as
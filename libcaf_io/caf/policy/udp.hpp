@@ -18,8 +18,11 @@
 
 #pragma once
 
+#include <vector>
+
 #include "caf/io/network/ip_endpoint.hpp"
 #include "caf/io/network/native_socket.hpp"
+#include "caf/io/network/receive_buffer.hpp"
 
 namespace caf {
 namespace policy {
@@ -42,6 +45,27 @@ struct udp {
                              void* buf, size_t buf_len,
                              const io::network::ip_endpoint& ep);
 
+  /// Maximum number of datagrams for `read_datagrams` and `write_datagrams`.
+  static constexpr size_t max_batch_size = 64;
+
+  /// Receives up to `num` datagrams with a single system call if the platform
+  /// supports it (`recvmmsg`). Stores the number of received datagrams in
+  /// `result` (0 if no datagram is available), the size of the n-th datagram
+  /// in `sizes[n]` and its sender in `eps[n]`. Returns `true` as long as no
+  /// IO error occurs.
+  static bool read_datagrams(size_t& result, io::network::native_socket fd,
+                             io::network::receive_buffer* bufs, size_t* sizes,
+                             io::network::ip_endpoint* eps, size_t num);
+
+  /// Sends up to `num` datagrams with a single system call if the platform
+  /// supports it (`sendmmsg`), addressing the content of `bufs[n]` at
+  /// `eps[n]`. Stores the number of sent datagrams in `result`. Returns
+  /// `true` as long as no IO error occurs.
+  static bool write_datagrams(size_t& result, io::network::native_socket fd,
+                              const std::vector<char>* const* bufs,
+                              const io::network::ip_endpoint* const* eps,
+                              size_t num);
+
   /// Always returns `false`. Native UDP I/O event handlers only rely on the
   /// socket buffer.
   static constexpr bool must_read_more(io::network::native_socket, size_t) {
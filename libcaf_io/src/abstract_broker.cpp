@@ -378,12 +378,17 @@ void abstract_broker::init_broker() {
     kvp.second->launch();
 }
 
-abstract_broker::abstract_broker(actor_config& cfg) : scheduled_actor(cfg) {
-  // nop
+abstract_broker::abstract_broker(actor_config& cfg)
+    : scheduled_actor(cfg),
+      backend_(dynamic_cast<network::multiplexer*>(cfg.host)) {
+  // Brokers run in the multiplexer they were spawned at. Fall back to the
+  // default backend if the host is not a multiplexer.
+  if (backend_ == nullptr)
+    backend_ = &system().middleman().backend();
 }
 
 network::multiplexer& abstract_broker::backend() {
-  return system().middleman().backend();
+  return *backend_;
 }
 
 void abstract_broker::launch_servant(doorman_ptr& ptr) {
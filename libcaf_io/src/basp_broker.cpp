@@ -78,7 +78,18 @@ basp_broker_state::basp_broker_state(broker* selfptr)
       max_buffers(get_or(self->config(), "middleman.cached-udp-buffers",
                          defaults::middleman::cached_udp_buffers)),
       max_pending_messages(get_or(self->config(), "middleman.max-pending-msgs",
-                                  defaults::middleman::max_pending_msgs)) {
+                                  defaults::middleman::max_pending_msgs)),
+      reliable_window(get_or(self->config(), "middleman.reliable-udp-window",
+                             defaults::middleman::reliable_udp_window)),
+      flush_threshold(get_or(self->config(), "middleman.flush-threshold",
+                             defaults::middleman::flush_threshold)),
+      max_flush_delay(get_or(self->config(), "middleman.max-flush-delay",
+                             defaults::middleman::max_flush_delay)),
+      parallel_deserialization(
+        get_or(self->config(), "middleman.enable-parallel-deserialization",
+               false)),
+      framed_reads(get_or(self->config(), "middleman.enable-framed-reads",
+                          false)) {
   CAF_ASSERT(this_node() != none);
 }
 
@@ -114,8 +125,11 @@ strong_actor_ptr basp_broker_state::make_proxy(node_id nid, actor_id aid) {
   // receive a kill_proxy_instance message
   auto mm = &system().middleman();
   actor_config cfg;
+  // the proxy applies backpressure once the connection to the next hop is
+  // congested
   auto res = make_actor<forwarding_actor_proxy, strong_actor_ptr>(
-    aid, nid, &(self->home_system()), cfg, self);
+    aid, nid, &(self->home_system()), cfg, self,
+    instance.gate(path->next_hop));
   strong_actor_ptr selfptr{self->ctrl()};
   res->get()->attach_functor([=](const error& rsn) {
     mm->backend().post([=] {
@@ -133,10 +147,10 @@ strong_actor_ptr basp_broker_state::make_proxy(node_id nid, actor_id aid) {
   auto& ctx = *this_context;
   // tell remote side we are monitoring this actor now
   instance.write_announce_proxy(self->context(),
-                                get_buffer(this_context->hdl),
+                                this_context->hdl,
                                 nid, aid,
                                 ctx.requires_ordering ? ctx.seq_outgoing++ : 0);
-  instance.flush(*path);
+  flush(this_context->hdl);
   mm->notify<hook::new_remote_actor>(res);
   return res;
 }
@@ -150,6 +164,9 @@ void basp_broker_state::finalize_handshake(const node_id& nid, actor_id aid,
   CAF_LOG_TRACE(CAF_ARG(nid) << CAF_ARG(aid) << CAF_ARG(sigs));
   CAF_ASSERT(this_context != nullptr);
   this_context->id = nid;
+  if (!this_context->lane && this_context->hdl.is<connection_handle>()
+      && instance.tbl().lookup_direct(nid) == this_context->hdl)
+    open_lanes(get<connection_handle>(this_context->hdl));
   auto& cb = this_context->callback;
   if (cb == none)
     return;
@@ -169,6 +186,23 @@ void basp_broker_state::finalize_handshake(const node_id& nid, actor_id aid,
   cb = none;
 }
 
+void basp_broker_state::open_lanes(connection_handle hdl) {
+  CAF_LOG_TRACE(CAF_ARG(hdl));
+  auto n = get_or(config(), "middleman.connections-per-peer",
+                  defaults::middleman::connections_per_peer);
+  auto port = this_context->remote_port;
+  if (n < 2 || port == 0)
+    return;
+  // Connecting blocks, hence we let a helper open the connections.
+  auto host = self->remote_addr(hdl);
+  auto bhdl = actor_cast<actor>(self);
+  if (get_or(config(), "middleman.attach-utility-actors", false))
+    system().spawn<hidden>(lane_helper, bhdl, std::move(host), port, n - 1);
+  else
+    system().spawn<detached + hidden>(lane_helper, bhdl, std::move(host), port,
+                                      n - 1);
+}
+
 void basp_broker_state::purge_state(const node_id& nid) {
   CAF_LOG_TRACE(CAF_ARG(nid));
   // Destroy all proxies of the lost node.
@@ -183,14 +217,16 @@ void basp_broker_state::send_kill_proxy_instance(const node_id& nid,
   CAF_LOG_TRACE(CAF_ARG(nid) << CAF_ARG(aid) << CAF_ARG(rsn));
   if (rsn == none)
     rsn = exit_reason::unknown;
-  auto path = instance.tbl().lookup(nid);
+  // Use the lane of the terminated actor to make sure the remote side
+  // receives all messages of the actor before destroying its proxy.
+  auto path = instance.tbl().lookup(nid, aid);
   if (!path) {
     CAF_LOG_INFO("cannot send exit message for proxy, no route to host:"
                  << CAF_ARG(nid));
     return;
   }
   instance.write_kill_proxy(self->context(),
-                            get_buffer(path->hdl),
+                            path->hdl,
                             nid, aid, rsn,
                             visit(seq_num_visitor{this}, path->hdl));
   instance.flush(*path);
@@ -316,6 +352,72 @@ void basp_broker_state::deliver(const node_id& src_nid, actor_id src_aid,
                 nullptr);
 }
 
+bool basp_broker_state::deliver_later(const endpoint_handle& hdl,
+                                      const basp::header& hdr,
+                                      atom_value dest_name,
+                                      std::vector<strong_actor_ptr>& stages,
+                                      const char* content, size_t len) {
+  CAF_LOG_TRACE(CAF_ARG(hdl) << CAF_ARG(hdr) << CAF_ARG(len));
+  // Hooks expect the deserialized message and datagrams have no strand.
+  if (!parallel_deserialization || !hdl.is<connection_handle>()
+      || self->parent().has_hook())
+    return false;
+  auto& reg = system().registry();
+  auto dest = hdr.has(basp::header::named_receiver_flag)
+              ? reg.get(dest_name)
+              : reg.get(hdr.dest_actor);
+  // Let deliver() handle all errors.
+  if (!dest)
+    return false;
+  auto src = hdr.source_node == this_node()
+             ? reg.get(hdr.source_actor)
+             : proxies().get_or_put(hdr.source_node, hdr.source_actor);
+  auto& strand = strands[get<connection_handle>(hdl)];
+  if (!strand)
+    strand = make_counted<basp::message_strand>(system(),
+                                               strong_actor_ptr{self->ctrl()});
+  strand->push({hdr, std::move(src), std::move(dest), std::move(stages),
+                buffer_type(content, content + len)});
+  return true;
+}
+
+bool basp_broker_state::enqueue_ordered(const endpoint_handle& hdl,
+                                        const basp::header& hdr,
+                                        const buffer_type& payload) {
+  if (!hdl.is<connection_handle>())
+    return false;
+  auto i = strands.find(get<connection_handle>(hdl));
+  if (i == strands.end() || i->second->idle())
+    return false;
+  i->second->push({hdr, nullptr, nullptr, {}, payload});
+  return true;
+}
+
+void basp_broker_state::deliver_parked(basp::message_strand& strand) {
+  auto& x = strand.parked();
+  CAF_LOG_TRACE(CAF_ARG(x.hdr));
+  binary_deserializer bd{self->context(), x.payload};
+  bd.varint_encoding(basp::uses_varint_encoding(x.hdr));
+  if (x.hdr.operation == basp::message_type::kill_proxy) {
+    error fail_state;
+    auto e = bd(fail_state);
+    if (e)
+      CAF_LOG_ERROR("failed to deserialize kill_proxy:" << CAF_ARG(e));
+    else
+      proxies().erase(x.hdr.source_node, x.hdr.source_actor,
+                      std::move(fail_state));
+  } else {
+    message msg;
+    auto e = msg.load(bd);
+    if (e)
+      CAF_LOG_ERROR("failed to deserialize message:" << CAF_ARG(e));
+    else
+      deliver(x.hdr.source_node, x.hdr.source_actor, std::move(x.dest),
+              make_message_id(x.hdr.operation_data), x.stages, msg);
+  }
+  strand.unpark();
+}
+
 void basp_broker_state::learned_new_node(const node_id& nid) {
   CAF_LOG_TRACE(CAF_ARG(nid));
   if (spawn_servers.count(nid) > 0) {
@@ -378,7 +480,7 @@ void basp_broker_state::learned_new_node(const node_id& nid) {
                    visit(seq_num_visitor{this}, path->hdl)};
   // writing std::numeric_limits<actor_id>::max() is a hack to get
   // this send-to-named-actor feature working with older CAF releases
-  instance.write(self->context(), get_buffer(path->hdl),
+  instance.write(self->context(), path->hdl,
                  hdr, &writer);
   instance.flush(*path);
 }
@@ -426,7 +528,7 @@ void basp_broker_state::learned_new_node_indirectly(const node_id& nid) {
                      basp::header::named_receiver_flag,
                      0, 0, this_node(), nid, tmp.id(), invalid_actor_id,
                      visit(seq_num_visitor{this}, path->hdl)};
-    instance.write(self->context(), get_buffer(path->hdl),
+    instance.write(self->context(), path->hdl,
                    hdr, &writer);
     instance.flush(*path);
   };
@@ -449,7 +551,8 @@ void basp_broker_state::set_context(connection_handle hdl) {
                      0, 0, none, none,
                      invalid_actor_id, invalid_actor_id},
         hdl, none, 0, 0, none, false, 0, 0,
-        basp::endpoint_context::pending_map(), false
+        basp::endpoint_context::pending_map(), false, false, false, {}, {}, false, {},
+        false, false
       }
     ).first;
   }
@@ -469,7 +572,8 @@ void basp_broker_state::set_context(datagram_handle hdl) {
                      0, 0, 0, none, none,
                      invalid_actor_id, invalid_actor_id},
         hdl, none, 0, 0, none, true, 0, 0,
-        basp::endpoint_context::pending_map(), false
+        basp::endpoint_context::pending_map(), false, false, false, {}, {}, false, {},
+        false, false
       }
     ).first;
   }
@@ -478,13 +582,25 @@ void basp_broker_state::set_context(datagram_handle hdl) {
 
 void basp_broker_state::cleanup(connection_handle hdl) {
   CAF_LOG_TRACE(CAF_ARG(hdl));
+  // Losing the direct connection to a node also drops all of its lanes.
+  auto& tbl = instance.tbl();
+  std::vector<endpoint_handle> lanes;
+  if (!tbl.is_lane(hdl))
+    lanes = tbl.lanes(tbl.lookup_direct(hdl));
   // Remove handle from the routing table and clean up any node-specific state
   // we might still have.
   auto cb = make_callback([&](const node_id& nid) -> error {
     purge_state(nid);
     return none;
   });
-  instance.tbl().erase_direct(hdl, cb);
+  tbl.erase_direct(hdl, cb);
+  instance.drop_fragments(hdl);
+  instance.drop_flow(hdl);
+  for (auto& x : lanes) {
+    auto lane = get<connection_handle>(x);
+    self->close(lane);
+    cleanup(lane);
+  }
   // Remove the context for `hdl`, making sure clients receive an error in case
   // this connection was closed during handshake.
   auto i = ctx_tcp.find(hdl);
@@ -497,6 +613,9 @@ void basp_broker_state::cleanup(connection_handle hdl) {
     }
     ctx_tcp.erase(i);
   }
+  coalesced.erase(hdl);
+  strands.erase(hdl);
+  batches.erase(hdl);
 }
 
 void basp_broker_state::cleanup(datagram_handle hdl) {
@@ -520,6 +639,8 @@ void basp_broker_state::cleanup(datagram_handle hdl) {
     }
     ctx_udp.erase(i);
   }
+  windows.erase(hdl);
+  retransmit_timers.erase(hdl);
 }
 
 basp::sequence_type basp_broker_state::next_sequence_number(connection_handle) {
@@ -542,6 +663,10 @@ void basp_broker_state::add_pending(execution_unit* ctx,
   if (!ep.requires_ordering)
     return;
   ep.pending.emplace(seq, std::make_pair(std::move(hdr), std::move(payload)));
+  // Reliable endpoints never skip missing datagrams, since the sender
+  // retransmits them. The sliding window bounds the pending messages.
+  if (ep.reliable)
+    return;
   if (ep.pending.size() >= max_pending_messages)
     deliver_pending(ctx, ep, true);
   else if (!ep.did_set_timeout)
@@ -569,7 +694,7 @@ bool basp_broker_state::deliver_pending(execution_unit* ctx,
     ep.seq_incoming += 1;
   }
   // Set a timeout if there are still pending messages.
-  if (!ep.pending.empty() && !ep.did_set_timeout)
+  if (!ep.reliable && !ep.pending.empty() && !ep.did_set_timeout)
     self->delayed_send(self, pending_to, pending_atom::value,
                        get<datagram_handle>(ep.hdl));
   return true;
@@ -599,6 +724,10 @@ basp_broker_state::get_buffer(datagram_handle) {
 
 basp_broker_state::buffer_type&
 basp_broker_state::get_buffer(connection_handle hdl) {
+  // Collect messages in a separate buffer for compressing them at once.
+  auto i = ctx_tcp.find(hdl);
+  if (i != ctx_tcp.end() && i->second.compression)
+    return batches[hdl];
   return self->wr_buf(hdl);
 }
 
@@ -618,15 +747,120 @@ void basp_broker_state::flush(endpoint_handle hdl) {
 }
 
 void basp_broker_state::flush(datagram_handle hdl) {
-  if (!cached_buffers.empty() && !cached_buffers.top().empty())
-    self->enqueue_datagram(hdl, pop_datagram_buffer(hdl));
+  if (!cached_buffers.empty() && !cached_buffers.top().empty()) {
+    auto i = ctx_udp.find(hdl);
+    if (i != ctx_udp.end() && i->second.reliable)
+      send_reliable(hdl, pop_datagram_buffer(hdl));
+    else
+      self->enqueue_datagram(hdl, pop_datagram_buffer(hdl));
+  }
+  self->flush(hdl);
+}
+
+void basp_broker_state::handle_ack(execution_unit*, basp::endpoint_context& ep,
+                                   const basp::header& hdr) {
+  CAF_LOG_TRACE(CAF_ARG(hdr));
+  if (!ep.reliable)
+    return;
+  auto hdl = get<datagram_handle>(ep.hdl);
+  auto i = windows.find(hdl);
+  if (i == windows.end())
+    return;
+  i->second.ack(hdr.sequence_number, hdr.operation_data, self->clock().now(),
+                [&](const buffer_type& buf) {
+                  self->enqueue_datagram(hdl, buf);
+                });
+  self->flush(hdl);
+  arm_retransmit(hdl);
+}
+
+void basp_broker_state::send_reliable(datagram_handle hdl, buffer_type buf) {
+  basp::header hdr;
+  binary_deserializer bd{self->context(), buf};
+  if (bd(hdr) || hdr.operation == basp::message_type::ack) {
+    // Acknowledgements are never acknowledged themselves.
+    self->enqueue_datagram(hdl, std::move(buf));
+    return;
+  }
+  auto i = windows.find(hdl);
+  if (i == windows.end())
+    i = windows.emplace(hdl, basp::sliding_window{reliable_window}).first;
+  i->second.push(hdr.sequence_number, std::move(buf), self->clock().now(),
+                 [&](const buffer_type& x) {
+                   self->enqueue_datagram(hdl, x);
+                 });
+  arm_retransmit(hdl);
+}
+
+void basp_broker_state::retransmit(datagram_handle hdl) {
+  CAF_LOG_TRACE(CAF_ARG(hdl));
+  retransmit_timers.erase(hdl);
+  auto i = windows.find(hdl);
+  if (i == windows.end())
+    return;
+  i->second.timeout(self->clock().now(), [&](const buffer_type& buf) {
+    self->enqueue_datagram(hdl, buf);
+  });
   self->flush(hdl);
+  arm_retransmit(hdl);
+}
+
+void basp_broker_state::arm_retransmit(datagram_handle hdl) {
+  if (retransmit_timers.count(hdl) > 0)
+    return;
+  auto i = windows.find(hdl);
+  if (i == windows.end())
+    return;
+  auto deadline = i->second.deadline();
+  if (!deadline)
+    return;
+  auto now = self->clock().now();
+  auto delay = *deadline > now ? *deadline - now
+                               : basp::sliding_window::duration_type{0};
+  self->delayed_send(self, delay, retransmit_atom::value, hdl);
+  retransmit_timers.emplace(hdl);
 }
 
 void basp_broker_state::flush(connection_handle hdl) {
+  if (flush_threshold == 0 || get_buffer(hdl).size() >= flush_threshold) {
+    flush_batch(hdl);
+    return;
+  }
+  // Collect all writes of the current batch and flush them at once, i.e.,
+  // after processing all messages that arrived before our flush_atom.
+  if (coalesced.empty()) {
+    if (max_flush_delay.count() > 0)
+      self->delayed_send(self, max_flush_delay, flush_atom::value);
+    else
+      self->send(self, flush_atom::value);
+  }
+  coalesced.emplace(hdl);
+}
+
+void basp_broker_state::flush_coalesced() {
+  CAF_LOG_TRACE(CAF_ARG(coalesced.size()));
+  for (auto& hdl : coalesced)
+    flush_batch(hdl);
+  coalesced.clear();
+}
+
+void basp_broker_state::flush_batch(connection_handle hdl) {
+  auto i = batches.find(hdl);
+  if (i != batches.end() && !i->second.empty())
+    instance.write_batch(self->context(), hdl, i->second, self->wr_buf(hdl));
   self->flush(hdl);
 }
 
+basp::endpoint_context*
+basp_broker_state::find_context(const endpoint_handle& hdl) {
+  if (hdl.is<connection_handle>()) {
+    auto i = ctx_tcp.find(get<connection_handle>(hdl));
+    return i != ctx_tcp.end() ? &i->second : nullptr;
+  }
+  auto i = ctx_udp.find(get<datagram_handle>(hdl));
+  return i != ctx_udp.end() ? &i->second : nullptr;
+}
+
 /******************************************************************************
  *                                basp_broker                                 *
  ******************************************************************************/
@@ -682,18 +916,37 @@ behavior basp_broker::make_behavior() {
       CAF_LOG_TRACE(CAF_ARG(msg.handle));
       state.set_context(msg.handle);
       auto& ctx = *state.this_context;
-      auto next = state.instance.handle(context(), msg, ctx.hdr,
-                                        ctx.cstate == basp::await_payload);
+      auto was_compact = ctx.compact_headers;
+      auto next = ctx.cstate == basp::await_frames
+                  ? state.instance.handle_frames(context(), msg, ctx.hdr)
+                  : state.instance.handle(context(), msg, ctx.hdr,
+                                          ctx.cstate == basp::await_payload);
       if (next == basp::close_connection) {
         state.cleanup(msg.handle);
         close(msg.handle);
         return;
       }
-      if (next != ctx.cstate) {
-        auto rd_size = next == basp::await_payload
-                       ? ctx.hdr.payload_len
-                       : basp::header_size;
-        configure_read(msg.handle, receive_policy::exactly(rd_size));
+      // The header size no longer changes after receiving the handshake of
+      // the remote side. From then on, the scribe may read ahead and deliver
+      // all complete messages of a single read at once.
+      if (next == basp::await_header && state.framed_reads
+          && state.instance.tbl().lookup_direct(msg.handle) != none)
+        next = basp::await_frames;
+      if (next != ctx.cstate || was_compact != ctx.compact_headers) {
+        auto hdr_size = basp::incoming_header_size(ctx);
+        switch (next) {
+          case basp::await_payload:
+            configure_read(msg.handle,
+                           receive_policy::exactly(ctx.hdr.payload_len));
+            break;
+          case basp::await_frames:
+            configure_read(msg.handle,
+                           receive_policy::framed(hdr_size,
+                                                  basp::payload_len_offset));
+            break;
+          default:
+            configure_read(msg.handle, receive_policy::exactly(hdr_size));
+        }
         ctx.cstate = next;
       }
     },
@@ -782,7 +1035,7 @@ behavior basp_broker::make_behavior() {
                        0, cme->mid.integer_value(), state.this_node(),
                        dest_node, src->id(), invalid_actor_id,
                        visit(seq_num_visitor{&state}, path->hdl)};
-      state.instance.write(context(), state.get_buffer(path->hdl),
+      state.instance.write(context(), path->hdl,
                            hdr, &writer);
       state.instance.flush(*path);
       return delegated<message>();
@@ -796,6 +1049,11 @@ behavior basp_broker::make_behavior() {
       state.flush(msg.handle);
       configure_read(msg.handle, receive_policy::exactly(basp::header_size));
     },
+    // received from underlying broker implementation while sending fragments
+    [=](const data_transferred_msg& msg) {
+      state.instance.handle_data_transferred(context(), msg.handle,
+                                             msg.remaining);
+    },
     // received from underlying broker implementation
     [=](const connection_closed_msg& msg) {
       CAF_LOG_TRACE(CAF_ARG(msg.handle));
@@ -834,6 +1092,20 @@ behavior basp_broker::make_behavior() {
       // await server handshake
       configure_read(hdl, receive_policy::exactly(basp::header_size));
     },
+    // received from lane helpers
+    [=](lane_atom, scribe_ptr& ptr) {
+      CAF_LOG_TRACE(CAF_ARG(ptr));
+      CAF_ASSERT(ptr != nullptr);
+      auto hdl = ptr->hdl();
+      add_scribe(std::move(ptr));
+      auto& ctx = state.ctx_tcp[hdl];
+      ctx.hdl = hdl;
+      ctx.cstate = basp::await_header;
+      ctx.requires_ordering = false;
+      ctx.lane = true;
+      // await server handshake
+      configure_read(hdl, receive_policy::exactly(basp::header_size));
+    },
     [=](publish_udp_atom, datagram_servant_ptr& ptr, uint16_t port,
         const strong_actor_ptr& whom, std::set<std::string>& sigs) {
       CAF_LOG_TRACE(CAF_ARG(ptr) << CAF_ARG(port)
@@ -880,7 +1152,7 @@ behavior basp_broker::make_behavior() {
       CAF_LOG_TRACE(CAF_ARG(whom) << CAF_ARG(port));
       auto cb = make_callback(
         [&](const strong_actor_ptr&, uint16_t x) -> error {
-          close(hdl_by_port(x));
+          close_doormen(x);
           return none;
         }
       );
@@ -906,7 +1178,7 @@ behavior basp_broker::make_behavior() {
       // it is well-defined behavior to not have an actor published here,
       // hence the result can be ignored safely
       state.instance.remove_published_actor(port, nullptr);
-      auto res = close(hdl_by_port(port));
+      auto res = close_doormen(port);
       if (res)
         return unit;
       return sec::cannot_close_invalid_port;
@@ -922,6 +1194,17 @@ behavior basp_broker::make_behavior() {
       }
       return std::make_tuple(x, std::move(addr), port);
     },
+    [=](get_atom, pending_atom, const node_id& x) -> size_t {
+      return state.instance.buffered_bytes(x);
+    },
+    // received from strands that cannot deliver a message on their own
+    [=](const basp::message_strand_ptr& strand) {
+      state.deliver_parked(*strand);
+    },
+    // received from ourselves after coalescing writes
+    [=](flush_atom) {
+      state.flush_coalesced();
+    },
     [=](tick_atom, size_t interval) {
       state.instance.handle_heartbeat(context());
       delayed_send(this, std::chrono::milliseconds{interval},
@@ -930,7 +1213,7 @@ behavior basp_broker::make_behavior() {
     [=](pending_atom, datagram_handle hdl) {
       auto& ep = state.ctx_udp[hdl];
       ep.did_set_timeout = false;
-      if (ep.pending.empty())
+      if (ep.reliable || ep.pending.empty())
         return;
       auto i = ep.pending.begin();
       auto seq = i->first;
@@ -941,6 +1224,11 @@ behavior basp_broker::make_behavior() {
       } else {
         state.drop_pending(ep, seq);
       }
+    },
+    // received from ourselves when the oldest unacknowledged datagram of a
+    // reliable endpoint times out
+    [=](retransmit_atom, datagram_handle hdl) {
+      state.retransmit(hdl);
     }
   };
 }
@@ -953,6 +1241,13 @@ resumable::resume_result basp_broker::resume(execution_unit* ctx, size_t mt) {
   return super::resume(ctx, mt);
 }
 
+bool basp_broker::close_doormen(uint16_t port) {
+  auto result = false;
+  for (auto hdl = hdl_by_port(port); close(hdl); hdl = hdl_by_port(port))
+    result = true;
+  return result;
+}
+
 proxy_registry* basp_broker::proxy_registry_ptr() {
   return &state.instance.proxies();
 }
@@ -0,0 +1,130 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/io/network/buffer_pool.hpp"
+
+#include <algorithm>
+
+namespace caf {
+namespace io {
+namespace network {
+
+namespace {
+
+// Number of larger size classes `acquire` checks before allocating a new
+// buffer, i.e., a cached buffer has at most four times the requested size.
+constexpr size_t max_class_distance = 2;
+
+// Returns the smallest size class that holds buffers of `size` bytes.
+size_t class_for_size(size_t size) {
+  size_t result = buffer_pool::min_class;
+  while (result < buffer_pool::max_class && (size_t{1} << result) < size)
+    ++result;
+  return result;
+}
+
+// Returns the largest size class with buffers not exceeding `capacity`.
+size_t class_for_capacity(size_t capacity) {
+  size_t result = buffer_pool::min_class;
+  while (result < buffer_pool::max_class
+         && (size_t{1} << (result + 1)) <= capacity)
+    ++result;
+  return result;
+}
+
+} // namespace <anonymous>
+
+constexpr size_t buffer_pool::min_class;
+
+constexpr size_t buffer_pool::max_class;
+
+constexpr size_t buffer_pool::num_classes;
+
+buffer_pool::buffer_pool(size_t capacity) : capacity_(capacity) {
+  // nop
+}
+
+void buffer_pool::acquire(buffer_type& buf, size_t size) {
+  auto c = class_for_size(size);
+  auto reserved = std::max(size, size_t{1} << c);
+  buffer_type tmp;
+  { // lifetime scope of guard
+    std::unique_lock<std::mutex> guard{mtx_};
+    ++stats_.acquired;
+    if (size <= (size_t{1} << max_class)) {
+      auto last = std::min(c + max_class_distance, max_class);
+      for (auto i = c; i <= last; ++i) {
+        auto& xs = lists_[i - min_class];
+        if (!xs.empty()) {
+          tmp.swap(xs.back());
+          xs.pop_back();
+          ++stats_.reused;
+          --stats_.cached_buffers;
+          stats_.cached_bytes -= tmp.capacity();
+          break;
+        }
+      }
+    }
+  }
+  // Allocate outside of the critical section on a miss.
+  if (tmp.capacity() == 0)
+    tmp.reserve(reserved);
+  buf.swap(tmp);
+}
+
+void buffer_pool::release(buffer_type& buf) {
+  auto cap = buf.capacity();
+  if (cap < (size_t{1} << min_class)) {
+    buffer_type{}.swap(buf);
+    return;
+  }
+  // Declaring `tmp` before `guard` deallocates dropped buffers after leaving
+  // the critical section.
+  buffer_type tmp;
+  tmp.swap(buf);
+  tmp.clear();
+  std::unique_lock<std::mutex> guard{mtx_};
+  if (cap >= (size_t{1} << (max_class + 1))
+      || stats_.cached_bytes + cap > capacity_) {
+    ++stats_.dropped;
+    return;
+  }
+  lists_[class_for_capacity(cap) - min_class].emplace_back(std::move(tmp));
+  ++stats_.released;
+  ++stats_.cached_buffers;
+  stats_.cached_bytes += cap;
+}
+
+void buffer_pool::clear() {
+  std::array<list_type, num_classes> tmp;
+  { // lifetime scope of guard
+    std::unique_lock<std::mutex> guard{mtx_};
+    tmp.swap(lists_);
+    stats_.cached_buffers = 0;
+    stats_.cached_bytes = 0;
+  }
+}
+
+buffer_pool::statistics buffer_pool::stats() const {
+  std::unique_lock<std::mutex> guard{mtx_};
+  return stats_;
+}
+
+} // namespace network
+} // namespace io
+} // namespace caf
@@ -128,6 +128,23 @@ behavior connection_helper(stateful_actor<connection_helper_state>* self,
   };
 }
 
+void lane_helper(event_based_actor* self, actor b, std::string host,
+                 uint16_t port, size_t num) {
+  CAF_LOG_TRACE(CAF_ARG(b) << CAF_ARG(host) << CAF_ARG(port) << CAF_ARG(num));
+  auto& mx = self->system().middleman().backend();
+  for (size_t i = 0; i < num; ++i) {
+    auto x = !host.empty() && host.front() == '/'
+             ? mx.new_local_scribe(host, port)
+             : mx.new_tcp_scribe(host, port);
+    if (!x) {
+      CAF_LOG_INFO("could not open additional connection:"
+                   << CAF_ARG(host) << CAF_ARG(port));
+      return;
+    }
+    self->send(b, lane_atom::value, std::move(*x));
+  }
+}
+
 } // namespace io
 } // namespace caf
 
@@ -26,6 +26,8 @@
 
 #include "caf/io/network/default_multiplexer.hpp"
 
+#include "caf/policy/udp.hpp"
+
 namespace {
 
 constexpr size_t receive_buffer_size = std::numeric_limits<uint16_t>::max();
@@ -44,9 +46,28 @@ datagram_handler::datagram_handler(default_multiplexer& backend_ref,
                defaults::middleman::max_consecutive_reads)),
       max_datagram_size_(receive_buffer_size),
       rd_buf_(receive_buffer_size),
+      batch_size_(std::max(size_t{1},
+                           std::min(get_or(backend().system().config(),
+                                           "middleman.datagram-batch-size",
+                                           defaults::middleman::
+                                             datagram_batch_size),
+                                    policy::udp::max_batch_size))),
+      rd_pos_(0),
+      rd_count_(0),
       send_buffer_size_(0),
       ack_writes_(false),
       writing_(false) {
+  if (batch_size_ > 1) {
+    // The storage of receive buffers remains uninitialized, i.e., the OS only
+    // maps pages that actually receive data.
+    rd_bufs_.reserve(batch_size_);
+    for (size_t i = 0; i < batch_size_; ++i)
+      rd_bufs_.emplace_back(receive_buffer_size);
+    rd_sizes_.resize(batch_size_);
+    rd_senders_.resize(batch_size_);
+    wr_batch_bufs_.reserve(batch_size_);
+    wr_batch_eps_.reserve(batch_size_);
+  }
   allow_udp_connreset(sockfd, false);
   auto es = send_buffer_size(sockfd);
   if (!es)
@@ -66,6 +87,15 @@ void datagram_handler::activate(datagram_manager* mgr) {
     reader_.reset(mgr);
     event_handler::activate();
     prepare_next_read();
+    // Datagrams of a batch that arrived before passivating the handler do
+    // not trigger another read event.
+    if (rd_pos_ < rd_count_) {
+      manager_ptr ptr{mgr};
+      backend().post([=] {
+        if (reader_ == ptr)
+          deliver_batch();
+      });
+    }
   }
 }
 
@@ -77,6 +107,7 @@ void datagram_handler::write(datagram_handle hdl, const void* buf,
                              size_t num_bytes) {
   wr_offline_buf_.emplace_back();
   wr_offline_buf_.back().first = hdl;
+  acquire_wr_buf(wr_offline_buf_.back().second);
   auto cbuf = reinterpret_cast<const char*>(buf);
   wr_offline_buf_.back().second.assign(cbuf,
                                        cbuf + static_cast<ptrdiff_t>(num_bytes));
@@ -149,7 +180,7 @@ void datagram_handler::prepare_next_read() {
 
 void datagram_handler::prepare_next_write() {
   CAF_LOG_TRACE(CAF_ARG(wr_offline_buf_.size()));
-  wr_buf_.second.clear();
+  release_wr_buf(wr_buf_.second);
   if (wr_offline_buf_.empty()) {
     writing_ = false;
     backend().del(operation::write, fd(), this);
@@ -165,19 +196,33 @@ bool datagram_handler::handle_read_result(bool read_result) {
     passivate();
     return false;
   }
-  if (num_bytes_ > 0) {
-    rd_buf_.resize(num_bytes_);
-    auto itr = hdl_by_ep_.find(sender_);
-    bool consumed = false;
-    if (itr == hdl_by_ep_.end())
-      consumed = reader_->new_endpoint(rd_buf_);
-    else
-      consumed = reader_->consume(&backend(), itr->second, rd_buf_);
-    prepare_next_read();
-    if (!consumed) {
-      passivate();
+  return deliver(rd_buf_, num_bytes_);
+}
+
+bool datagram_handler::deliver(read_buffer_type& buf, size_t num_bytes) {
+  if (num_bytes == 0)
+    return true;
+  buf.resize(num_bytes);
+  auto itr = hdl_by_ep_.find(sender_);
+  bool consumed = false;
+  if (itr == hdl_by_ep_.end())
+    consumed = reader_->new_endpoint(buf);
+  else
+    consumed = reader_->consume(&backend(), itr->second, buf);
+  buf.resize(max_datagram_size_);
+  if (!consumed) {
+    passivate();
+    return false;
+  }
+  return true;
+}
+
+bool datagram_handler::deliver_batch() {
+  while (rd_pos_ < rd_count_) {
+    auto i = rd_pos_++;
+    sender_ = rd_senders_[i];
+    if (!deliver(rd_bufs_[i], rd_sizes_[i]))
       return false;
-    }
   }
   return true;
 }
@@ -191,6 +236,8 @@ void datagram_handler::handle_write_result(bool write_result, datagram_handle id
     CAF_ASSERT(wb == buf.size());
     if (ack_writes_)
       writer_->datagram_sent(&backend(), id, wb, std::move(buf));
+    else
+      release_wr_buf(buf);
     prepare_next_write();
   } else {
     if (writer_)
@@ -198,6 +245,43 @@ void datagram_handler::handle_write_result(bool write_result, datagram_handle id
   }
 }
 
+void datagram_handler::handle_write_results(bool write_result,
+                                            size_t num_sent) {
+  if (!write_result) {
+    writer_->io_failure(&backend(), operation::write);
+    backend().del(operation::write, fd(), this);
+    return;
+  }
+  // Sending nothing means the socket buffer is full, i.e., we try again on
+  // the next write event.
+  for (size_t i = 0; i < num_sent; ++i) {
+    if (i > 0) {
+      release_wr_buf(wr_buf_.second);
+      wr_buf_.swap(wr_offline_buf_.front());
+      wr_offline_buf_.pop_front();
+    }
+    if (ack_writes_)
+      writer_->datagram_sent(&backend(), wr_buf_.first, wr_buf_.second.size(),
+                             std::move(wr_buf_.second));
+  }
+  if (num_sent > 0)
+    prepare_next_write();
+}
+
+void datagram_handler::acquire_wr_buf(write_buffer_type& buf) {
+  auto pool = backend().buffers();
+  if (pool != nullptr)
+    pool->acquire(buf, 0);
+}
+
+void datagram_handler::release_wr_buf(write_buffer_type& buf) {
+  auto pool = backend().buffers();
+  if (pool != nullptr)
+    pool->release(buf);
+  else
+    buf.clear();
+}
+
 void datagram_handler::handle_error() {
   if (reader_)
     reader_->io_failure(&backend(), operation::read);
@@ -32,6 +32,8 @@
 #include "caf/io/network/interfaces.hpp"
 #include "caf/io/network/scribe_impl.hpp"
 #include "caf/io/network/doorman_impl.hpp"
+#include "caf/io/network/local_scribe_impl.hpp"
+#include "caf/io/network/local_doorman_impl.hpp"
 #include "caf/io/network/datagram_servant_impl.hpp"
 
 #include "caf/detail/call_cfun.hpp"
@@ -69,6 +71,7 @@
 # include <netinet/tcp.h>
 # include <sys/socket.h>
 # include <sys/types.h>
+# include <sys/un.h>
 #ifdef CAF_POLL_MULTIPLEXER
 # include <poll.h>
 #elif defined(CAF_EPOLL_MULTIPLEXER)
@@ -698,6 +701,25 @@ expected<doorman_ptr> default_multiplexer::new_tcp_doorman(uint16_t port,
   return std::move(fd.error());
 }
 
+expected<scribe_ptr>
+default_multiplexer::new_local_scribe(const std::string& path, uint16_t port) {
+  CAF_LOG_TRACE(CAF_ARG(path) << CAF_ARG(port));
+  auto fd = new_local_connection(path);
+  if (!fd)
+    return std::move(fd.error());
+  return make_counted<local_scribe_impl>(*this, *fd, path, port);
+}
+
+expected<doorman_ptr>
+default_multiplexer::new_local_doorman(const std::string& path,
+                                       uint16_t port) {
+  CAF_LOG_TRACE(CAF_ARG(path) << CAF_ARG(port));
+  auto fd = new_local_acceptor_impl(path);
+  if (!fd)
+    return std::move(fd.error());
+  return make_counted<local_doorman_impl>(*this, *fd, path, port);
+}
+
 datagram_servant_ptr
 default_multiplexer::new_datagram_servant(native_socket fd) {
   CAF_LOG_TRACE(CAF_ARG(fd));
@@ -891,6 +913,74 @@ expected<native_socket> new_tcp_acceptor_impl(uint16_t port, const char* addr,
   return sguard.release();
 }
 
+#ifdef CAF_WINDOWS
+
+expected<native_socket> new_local_connection(const std::string& path) {
+  return make_error(sec::feature_disabled, "new_local_connection", path);
+}
+
+expected<native_socket> new_local_acceptor_impl(const std::string& path) {
+  return make_error(sec::feature_disabled, "new_local_acceptor_impl", path);
+}
+
+#else // CAF_WINDOWS
+
+namespace {
+
+expected<sockaddr_un> local_address(const std::string& path) {
+  sockaddr_un sa;
+  memset(&sa, 0, sizeof(sockaddr_un));
+  if (path.empty() || path.size() >= sizeof(sa.sun_path))
+    return make_error(sec::invalid_argument, "invalid socket path", path);
+  sa.sun_family = AF_UNIX;
+  memcpy(sa.sun_path, path.c_str(), path.size());
+  return sa;
+}
+
+} // namespace <anonymous>
+
+expected<native_socket> new_local_connection(const std::string& path) {
+  CAF_LOG_TRACE(CAF_ARG(path));
+  auto sa = local_address(path);
+  if (!sa)
+    return std::move(sa.error());
+  CALL_CFUN(fd, detail::cc_valid_socket, "socket",
+            socket(AF_UNIX, SOCK_STREAM, 0));
+  detail::socket_guard sguard{fd};
+  if (connect(fd, reinterpret_cast<const sockaddr*>(&*sa),
+              sizeof(sockaddr_un)) != 0) {
+    CAF_LOG_INFO("could not connect to:" << CAF_ARG(path));
+    return make_error(sec::cannot_connect_to_node, "connect failed", path);
+  }
+  return sguard.release();
+}
+
+expected<native_socket> new_local_acceptor_impl(const std::string& path) {
+  CAF_LOG_TRACE(CAF_ARG(path));
+  auto sa = local_address(path);
+  if (!sa)
+    return std::move(sa.error());
+  // Remove the socket file of a crashed process, but never steal the path
+  // from a running one.
+  auto conn = new_local_connection(path);
+  if (conn) {
+    close_socket(*conn);
+    return make_error(sec::cannot_open_port, "socket path in use", path);
+  }
+  unlink(path.c_str());
+  CALL_CFUN(fd, detail::cc_valid_socket, "socket",
+            socket(AF_UNIX, SOCK_STREAM, 0));
+  detail::socket_guard sguard{fd};
+  CALL_CFUN(tmp1, detail::cc_zero, "bind",
+            bind(fd, reinterpret_cast<const sockaddr*>(&*sa),
+                 sizeof(sockaddr_un)));
+  CALL_CFUN(tmp2, detail::cc_zero, "listen", listen(fd, SOMAXCONN));
+  CAF_LOG_DEBUG(CAF_ARG(fd));
+  return sguard.release();
+}
+
+#endif // CAF_WINDOWS
+
 expected<std::pair<native_socket, ip_endpoint>>
 new_remote_udp_endpoint_impl(const std::string& host, uint16_t port,
                              optional<protocol::network> preferred) {
@@ -0,0 +1,63 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/io/basp/fragment_scheduler.hpp"
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace io {
+namespace basp {
+
+fragment_scheduler::fragment_scheduler(size_t fragment_size)
+    : fragment_size_(fragment_size),
+      buffered_(0) {
+  CAF_ASSERT(fragment_size > 0);
+}
+
+bool fragment_scheduler::pending(flow_key key) const {
+  auto pred = [&](const flow& x) { return x.key == key; };
+  return std::any_of(flows_.begin(), flows_.end(), pred);
+}
+
+void fragment_scheduler::push(flow_key key, size_t weight, buffer_type data) {
+  buffered_ += data.size();
+  get_flow(key, weight).queue.emplace_back(
+    entry{std::move(data), 0, false, header{}});
+}
+
+void fragment_scheduler::push(flow_key key, size_t weight, buffer_type data,
+                              const header& hdr) {
+  buffered_ += data.size();
+  get_flow(key, weight).queue.emplace_back(
+    entry{std::move(data), 0, true, hdr});
+}
+
+fragment_scheduler::flow& fragment_scheduler::get_flow(flow_key key,
+                                                       size_t weight) {
+  auto pred = [&](const flow& x) { return x.key == key; };
+  auto i = std::find_if(flows_.begin(), flows_.end(), pred);
+  if (i != flows_.end())
+    return *i;
+  flows_.emplace_back(flow{key, weight, 0, {}});
+  return flows_.back();
+}
+
+} // namespace basp
+} // namespace io
+} // namespace caf
@@ -26,6 +26,10 @@ namespace basp {
 
 const uint8_t header::named_receiver_flag;
 
+const uint8_t header::varint_flag;
+
+const uint8_t header::compact_header_flag;
+
 std::string to_bin(uint8_t x) {
   std::string res;
   for (auto offset = 7; offset > -1; --offset)
@@ -121,6 +125,42 @@ bool heartbeat_valid(const header& hdr) {
        && zero(hdr.operation_data);
 }
 
+bool node_alias_valid(const header& hdr) {
+  return  valid(hdr.source_node)
+       && valid(hdr.dest_node)
+       && hdr.source_node != hdr.dest_node
+       && zero(hdr.source_actor)
+       && zero(hdr.dest_actor)
+       && !zero(hdr.payload_len)
+       && hdr.operation_data != endpoint_alias
+       && hdr.operation_data < none_alias;
+}
+
+bool fragment_valid(const header& hdr) {
+  return  valid(hdr.source_node)
+       && valid(hdr.dest_node)
+       && hdr.source_node != hdr.dest_node
+       && !zero(hdr.payload_len);
+}
+
+bool ack_valid(const header& hdr) {
+  return  valid(hdr.source_node)
+       && valid(hdr.dest_node)
+       && hdr.source_node != hdr.dest_node
+       && zero(hdr.source_actor)
+       && zero(hdr.dest_actor)
+       && zero(hdr.payload_len);
+}
+
+bool compressed_valid(const header& hdr) {
+  return  valid(hdr.source_node)
+       && valid(hdr.dest_node)
+       && hdr.source_node != hdr.dest_node
+       && zero(hdr.source_actor)
+       && zero(hdr.dest_actor)
+       && !zero(hdr.payload_len);
+}
+
 } // namespace <anonymous>
 
 bool valid(const header& hdr) {
@@ -139,6 +179,14 @@ bool valid(const header& hdr) {
       return kill_proxy_instance_valid(hdr);
     case message_type::heartbeat:
       return heartbeat_valid(hdr);
+    case message_type::node_alias:
+      return node_alias_valid(hdr);
+    case message_type::fragment:
+      return fragment_valid(hdr);
+    case message_type::ack:
+      return ack_valid(hdr);
+    case message_type::compressed:
+      return compressed_valid(hdr);
   }
 }
 
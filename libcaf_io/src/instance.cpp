@@ -18,10 +18,15 @@
 
 #include "caf/io/basp/instance.hpp"
 
+#include <algorithm>
+
 #include "caf/actor_system_config.hpp"
 #include "caf/binary_deserializer.hpp"
 #include "caf/binary_serializer.hpp"
 #include "caf/defaults.hpp"
+#include "caf/detail/scope_guard.hpp"
+#include "caf/io/basp/lz_codec.hpp"
+#include "caf/io/basp/sliding_window.hpp"
 #include "caf/io/basp/version.hpp"
 #include "caf/streambuf.hpp"
 
@@ -41,6 +46,28 @@ struct seq_num_visitor {
   instance::callee& cal;
 };
 
+// Writes `hdr` in compact form, followed by its payload, to `buf`.
+void write_compact(execution_unit* ctx, buffer_type& buf, header& hdr,
+                   alias_type source, alias_type dest,
+                   instance::payload_writer* pw) {
+  auto pos = buf.size();
+  buf.resize(pos + compact_header_size);
+  if (pw != nullptr) {
+    binary_serializer bs{ctx, buf};
+    bs.varint_encoding(uses_varint_encoding(hdr));
+    (*pw)(bs);
+    auto plen = buf.size() - pos - compact_header_size;
+    CAF_ASSERT(plen <= std::numeric_limits<uint32_t>::max());
+    hdr.payload_len = static_cast<uint32_t>(plen);
+  }
+  stream_serializer<charbuf> out{ctx, buf.data() + pos, compact_header_size};
+  auto err = out(hdr.operation, hdr.flags, hdr.sequence_number,
+                 hdr.payload_len, hdr.operation_data, source, dest,
+                 hdr.source_actor, hdr.dest_actor);
+  if (err)
+    CAF_LOG_ERROR(CAF_ARG(err));
+}
+
 } // namespace <anonymous>
 
 instance::callee::callee(actor_system& sys, proxy_registry::backend& backend)
@@ -55,55 +82,173 @@ instance::callee::~callee() {
 instance::instance(abstract_broker* parent, callee& lstnr)
     : tbl_(parent),
       this_node_(parent->system().node()),
-      callee_(lstnr) {
+      callee_(lstnr),
+      varint_encoding_(get_or(parent->system().config(),
+                              "middleman.enable-varint-encoding", false)),
+      compact_headers_(get_or(parent->system().config(),
+                              "middleman.enable-compact-headers", false)),
+      reliable_datagrams_(get_or(parent->system().config(),
+                                 "middleman.enable-reliable-udp", false)),
+      codec_(nullptr),
+      compression_threshold_(get_or(parent->system().config(),
+                                    "middleman.compression-threshold",
+                                    defaults::middleman::compression_threshold)),
+      fragment_size_(get_or(parent->system().config(),
+                            "middleman.fragment-size",
+                            defaults::middleman::fragment_size)),
+      next_fragment_id_(0),
+      high_watermark_(get_or(parent->system().config(),
+                             "middleman.high-watermark",
+                             defaults::middleman::high_watermark)),
+      low_watermark_(get_or(parent->system().config(),
+                            "middleman.low-watermark",
+                            defaults::middleman::low_watermark)),
+      backpressure_(flow_gate::mode::pause) {
   CAF_ASSERT(this_node_ != none);
+  if (low_watermark_ == 0)
+    low_watermark_ = high_watermark_ / 2;
+  else if (low_watermark_ > high_watermark_)
+    low_watermark_ = high_watermark_;
+  auto policy = get_or(parent->system().config(), "middleman.backpressure",
+                       defaults::middleman::backpressure);
+  if (policy == atom("drop"))
+    backpressure_ = flow_gate::mode::drop;
+  else if (policy == atom("error"))
+    backpressure_ = flow_gate::mode::error;
+  // Receivers decompress batches with any codec they know, while senders
+  // only use the configured codec.
+  codecs_.emplace_back(new lz_codec);
+  for (auto& f : parent->system().config().codec_factories)
+    codecs_.emplace_back(f());
+  auto name = get_or(parent->system().config(), "middleman.compression",
+                     defaults::middleman::compression);
+  if (name != atom("none")) {
+    for (auto& x : codecs_)
+      if (x->name() == name)
+        codec_ = x.get();
+    if (codec_ == nullptr)
+      CAF_LOG_ERROR("unknown compression codec:" << CAF_ARG(name));
+  }
+}
+
+instance::~instance() {
+  // Never leave local actors suspended after losing the broker.
+  for (auto& kvp : gates_)
+    kvp.second->open();
 }
 
 connection_state instance::handle(execution_unit* ctx,
                                   new_data_msg& dm, header& hdr,
                                   bool is_payload) {
   CAF_LOG_TRACE(CAF_ARG(dm) << CAF_ARG(is_payload));
-  // function object providing cleanup code on errors
-  auto err = [&]() -> connection_state {
-    auto cb = make_callback([&](const node_id& nid) -> error {
-      callee_.purge_state(nid);
-      return none;
-    });
-    tbl_.erase_direct(dm.handle, cb);
-    return close_connection;
-  };
   std::vector<char>* payload = nullptr;
   if (is_payload) {
     payload = &dm.buf;
     if (payload->size() != hdr.payload_len) {
       CAF_LOG_WARNING("received invalid payload, expected"
                       << hdr.payload_len << "bytes, got" << payload->size());
-      return err();
+      return drop(dm.handle);
     }
   } else {
     binary_deserializer bd{ctx, dm.buf};
-    auto e = bd(hdr);
-    if (e || !valid(hdr)) {
-      CAF_LOG_WARNING("received invalid header:" << CAF_ARG(hdr));
-      return err();
-    }
+    if (!read_header(bd, dm.handle, hdr))
+      return drop(dm.handle);
     if (hdr.payload_len > 0) {
       CAF_LOG_DEBUG("await payload before processing further");
       return await_payload;
     }
   }
+  return handle_message(ctx, dm.handle, hdr, payload);
+}
+
+connection_state instance::handle_frames(execution_unit* ctx,
+                                         new_data_msg& dm, header& hdr) {
+  CAF_LOG_TRACE(CAF_ARG(dm.handle) << CAF_ARG(dm.buf.size()));
+  auto first = dm.buf.data();
+  auto last = first + dm.buf.size();
+  if (handle_frames(ctx, dm.handle, first, last, hdr) == close_connection)
+    return close_connection;
+  return await_frames;
+}
+
+connection_state instance::handle_frames(execution_unit* ctx,
+                                         const connection_handle& hdl,
+                                         char* first, char* last, header& hdr) {
+  auto ep = callee_.find_context(hdl);
+  if (ep == nullptr)
+    return drop(hdl);
+  auto hsize = incoming_header_size(*ep);
+  std::vector<char> payload;
+  while (first != last) {
+    if (static_cast<size_t>(last - first) < hsize) {
+      CAF_LOG_WARNING("received incomplete header");
+      return drop(hdl);
+    }
+    binary_deserializer bd{ctx, first, hsize};
+    if (!read_header(bd, hdl, hdr))
+      return drop(hdl);
+    first += hsize;
+    if (static_cast<size_t>(last - first) < hdr.payload_len) {
+      CAF_LOG_WARNING("received incomplete payload");
+      return drop(hdl);
+    }
+    std::vector<char>* pptr = nullptr;
+    if (hdr.payload_len > 0) {
+      payload.assign(first, first + hdr.payload_len);
+      pptr = &payload;
+      first += hdr.payload_len;
+    }
+    if (handle_message(ctx, hdl, hdr, pptr) == close_connection)
+      return close_connection;
+  }
+  return await_header;
+}
+
+connection_state instance::handle_compressed(execution_unit* ctx,
+                                             const connection_handle& hdl,
+                                             const header& hdr,
+                                             std::vector<char>* payload) {
+  CAF_LOG_TRACE(CAF_ARG(hdl) << CAF_ARG(hdr));
+  auto name = static_cast<atom_value>(hdr.operation_data);
+  auto pred = [&](const codec_ptr& x) { return x->name() == name; };
+  auto i = std::find_if(codecs_.begin(), codecs_.end(), pred);
+  if (i == codecs_.end()) {
+    CAF_LOG_WARNING("received batch with unknown codec:" << CAF_ARG(name));
+    return drop(hdl);
+  }
+  uint32_t size = 0;
+  binary_deserializer bd{ctx, *payload};
+  if (payload->size() < sizeof(size) || bd(size))
+    return drop(hdl);
+  buffer_type batch;
+  if (!(*i)->decompress(payload->data() + sizeof(size),
+                        payload->size() - sizeof(size), size, batch)) {
+    CAF_LOG_WARNING("received malformed compressed batch");
+    return drop(hdl);
+  }
+  header inner;
+  return handle_frames(ctx, hdl, batch.data(), batch.data() + batch.size(),
+                       inner);
+}
+
+connection_state instance::handle_message(execution_unit* ctx,
+                                          const connection_handle& hdl,
+                                          header& hdr,
+                                          std::vector<char>* payload) {
   CAF_LOG_DEBUG(CAF_ARG(hdr));
+  if (hdr.operation == message_type::compressed)
+    return handle_compressed(ctx, hdl, hdr, payload);
   // needs forwarding?
   if (!is_handshake(hdr) && !is_heartbeat(hdr) && hdr.dest_node != this_node_) {
     CAF_LOG_DEBUG("forward message");
     auto path = lookup(hdr.dest_node);
     if (path) {
-      binary_serializer bs{ctx, callee_.get_buffer(path->hdl)};
-      auto e = bs(hdr);
-      if (e)
-        return err();
-      if (payload != nullptr)
-        bs.apply_raw(payload->size(), payload->data());
+      auto writer = make_callback([&](serializer& sink) -> error {
+        if (payload == nullptr)
+          return none;
+        return sink.apply_raw(payload->size(), payload->data());
+      });
+      write(ctx, path->hdl, hdr, &writer);
       flush(*path);
       notify<hook::message_forwarded>(hdr, payload);
     } else {
@@ -123,8 +268,8 @@ connection_state instance::handle(execution_unit* ctx,
     }
     return await_header;
   }
-  if (!handle(ctx, dm.handle, hdr, payload, true, none, none))
-    return err();
+  if (!handle(ctx, hdl, hdr, payload, true, none, none))
+    return drop(hdl);
   return await_header;
 }
 
@@ -154,6 +299,12 @@ bool instance::handle(execution_unit* ctx, new_datagram_msg& dm,
     return err();
   }
   CAF_LOG_DEBUG(CAF_ARG(ep.hdr));
+  // Acknowledgements bypass the ordering since they carry no sequence number
+  // of their own.
+  if (ep.hdr.operation == message_type::ack) {
+    callee_.handle_ack(ctx, ep, ep.hdr);
+    return true;
+  }
   std::vector<char>* payload = nullptr;
   if (ep.hdr.payload_len > 0) {
     payload = &pl_buf;
@@ -162,6 +313,17 @@ bool instance::handle(execution_unit* ctx, new_datagram_msg& dm,
       return err();
     }
   }
+  // Acknowledge each datagram on reliable endpoints, including duplicates and
+  // early datagrams. The handshake may enable reliability, hence we check
+  // after handling the datagram.
+  auto peer = ep.hdr.source_node;
+  auto ack_guard = detail::make_scope_guard([&] {
+    if (ep.reliable && peer != none) {
+      auto hdl = get<datagram_handle>(ep.hdl);
+      write_ack(ctx, callee_.get_buffer(hdl), ep, peer);
+      callee_.flush(hdl);
+    }
+  });
   // Handle ordering of datagrams.
   if (is_greater(ep.hdr.sequence_number, ep.seq_incoming)) {
     // Add early messages to the pending message buffer.
@@ -175,18 +337,17 @@ bool instance::handle(execution_unit* ctx, new_datagram_msg& dm,
   }
   // This is the expected message.
   ep.seq_incoming += 1;
-  // TODO: add optional reliability here
   if (!is_handshake(ep.hdr) && !is_heartbeat(ep.hdr)
       && ep.hdr.dest_node != this_node_) {
     CAF_LOG_DEBUG("forward message");
     auto path = lookup(ep.hdr.dest_node);
     if (path) {
-      binary_serializer bs{ctx, callee_.get_buffer(path->hdl)};
-      auto ex = bs(ep.hdr);
-      if (ex)
-        return err();
-      if (payload != nullptr)
-        bs.apply_raw(payload->size(), payload->data());
+      auto writer = make_callback([&](serializer& sink) -> error {
+        if (payload == nullptr)
+          return none;
+        return sink.apply_raw(payload->size(), payload->data());
+      });
+      write(ctx, path->hdl, ep.hdr, &writer);
       flush(*path);
       notify<hook::message_forwarded>(ep.hdr, payload);
     } else {
@@ -206,11 +367,15 @@ bool instance::handle(execution_unit* ctx, new_datagram_msg& dm,
     }
     return true;
   }
-  if (!handle(ctx, dm.handle, ep.hdr, payload, false, ep, ep.local_port))
+  if (!handle(ctx, dm.handle, ep.hdr, payload, false, ep, ep.local_port)) {
+    ack_guard.disable();
     return err();
+  }
   // See if the next message was delivered early and is already bufferd.
-  if (!callee_.deliver_pending(ctx, ep, false))
+  if (!callee_.deliver_pending(ctx, ep, false)) {
+    ack_guard.disable();
     return err();
+  }
   return true;
 }
 
@@ -218,12 +383,74 @@ void instance::handle_heartbeat(execution_unit* ctx) {
   CAF_LOG_TRACE("");
   for (auto& kvp: tbl_.direct_by_hdl_) {
     CAF_LOG_TRACE(CAF_ARG(kvp.first) << CAF_ARG(kvp.second));
-    write_heartbeat(ctx, callee_.get_buffer(kvp.first),
-                    kvp.second, visit(seq_num_visitor{callee_}, kvp.first));
+    write_heartbeat(ctx, kvp.first, kvp.second,
+                    visit(seq_num_visitor{callee_}, kvp.first));
     callee_.flush(kvp.first);
   }
 }
 
+void instance::handle_data_transferred(execution_unit* ctx,
+                                       connection_handle hdl,
+                                       size_t remaining) {
+  auto j = flows_.find(hdl);
+  if (j != flows_.end()) {
+    j->second.bytes = remaining;
+    check_watermarks(hdl, j->second);
+  }
+  auto i = fragments_.find(hdl);
+  if (i == fragments_.end() || remaining > fragment_size_)
+    return;
+  if (i->second.empty()) {
+    fragments_.erase(i);
+    // Flow control needs acknowledgements for as long as the connection lives.
+    if (j == flows_.end())
+      tbl_.parent()->ack_writes(hdl, false);
+    return;
+  }
+  write_fragments(ctx, hdl, i->second);
+}
+
+void instance::drop_fragments(const connection_handle& hdl) {
+  fragments_.erase(hdl);
+}
+
+void instance::drop_flow(const connection_handle& hdl) {
+  auto i = flows_.find(hdl);
+  if (i == flows_.end())
+    return;
+  auto peer = i->second.peer;
+  flows_.erase(i);
+  if (congested(peer))
+    return;
+  auto j = gates_.find(peer);
+  if (j == gates_.end())
+    return;
+  j->second->open();
+  // Proxies of a disconnected node keep their gate, but it never closes again.
+  if (!tbl_.lookup_direct(peer))
+    gates_.erase(j);
+}
+
+flow_gate_ptr instance::gate(const node_id& nid) {
+  if (high_watermark_ == 0)
+    return nullptr;
+  auto& result = gates_[nid];
+  if (!result) {
+    result = make_counted<flow_gate>(backpressure_);
+    if (congested(nid))
+      result->close();
+  }
+  return result;
+}
+
+size_t instance::buffered_bytes(const node_id& nid) const {
+  size_t result = 0;
+  for (auto& kvp : flows_)
+    if (kvp.second.peer == nid)
+      result += buffered_bytes(kvp.first, kvp.second);
+  return result;
+}
+
 optional<routing_table::route> instance::lookup(const node_id& target) {
   return tbl_.lookup(target);
 }
@@ -236,7 +463,7 @@ void instance::write(execution_unit* ctx, const routing_table::route& r,
                      header& hdr, payload_writer* writer) {
   CAF_LOG_TRACE(CAF_ARG(hdr));
   CAF_ASSERT(hdr.payload_len == 0 || writer != nullptr);
-  write(ctx, callee_.get_buffer(r.hdl), hdr, writer);
+  write(ctx, r.hdl, hdr, writer);
   flush(r);
 }
 
@@ -307,7 +534,13 @@ bool instance::dispatch(execution_unit* ctx, const strong_actor_ptr& sender,
   CAF_LOG_TRACE(CAF_ARG(sender) << CAF_ARG(receiver)
                 << CAF_ARG(mid) << CAF_ARG(msg));
   CAF_ASSERT(receiver && system().node() != receiver->node());
-  auto path = lookup(receiver->node());
+  // Urgent messages never queue up behind regular messages on a lane. All
+  // other messages use the lane of their sender. This keeps all messages of
+  // an actor in order, including down and exit messages after its death.
+  auto path = mid.is_urgent_message()
+              ? lookup(receiver->node())
+              : tbl_.lookup(receiver->node(),
+                            sender ? sender->id() : receiver->id());
   if (!path) {
     notify<hook::message_sending_failed>(sender, receiver, mid, msg);
     return false;
@@ -316,11 +549,12 @@ bool instance::dispatch(execution_unit* ctx, const strong_actor_ptr& sender,
     return sink(const_cast<std::vector<strong_actor_ptr>&>(forwarding_stack),
                 const_cast<message&>(msg));
   });
-  header hdr{message_type::dispatch_message, 0, 0, mid.integer_value(),
+  header hdr{message_type::dispatch_message,
+             payload_flags(*path, receiver->node()), 0, mid.integer_value(),
              sender ? sender->node() : this_node(), receiver->node(),
              sender ? sender->id() : invalid_actor_id, receiver->id(),
              visit(seq_num_visitor{callee_}, path->hdl)};
-  write(ctx, callee_.get_buffer(path->hdl), hdr, &writer);
+  write(ctx, path->hdl, hdr, &writer);
   flush(*path);
   notify<hook::message_sent>(sender, path->next_hop, receiver, mid, msg);
   return true;
@@ -336,6 +570,7 @@ void instance::write(execution_unit* ctx, buffer_type& buf,
     char placeholder[basp::header_size];
     buf.insert(buf.end(), std::begin(placeholder), std::end(placeholder));
     binary_serializer bs{ctx, buf};
+    bs.varint_encoding(uses_varint_encoding(hdr));
     (*pw)(bs);
     auto plen = buf.size() - pos - basp::header_size;
     CAF_ASSERT(plen <= std::numeric_limits<uint32_t>::max());
@@ -350,6 +585,180 @@ void instance::write(execution_unit* ctx, buffer_type& buf,
     CAF_LOG_ERROR(CAF_ARG(err));
 }
 
+void instance::write(execution_unit* ctx, const endpoint_handle& hdl,
+                     header& hdr, payload_writer* pw) {
+  CAF_LOG_TRACE(CAF_ARG(hdl) << CAF_ARG(hdr));
+  auto& buf = callee_.get_buffer(hdl);
+  auto before = buf.size();
+  size_t pos;
+  auto ep = callee_.find_context(hdl);
+  if (ep == nullptr || !ep->compact_headers) {
+    pos = buf.size();
+    write(ctx, buf, hdr, pw);
+  } else {
+    auto peer = tbl_.lookup_direct(hdl);
+    auto source = make_alias(ctx, hdl, *ep, hdr.source_node, this_node_);
+    auto dest = make_alias(ctx, hdl, *ep, hdr.dest_node, peer);
+    pos = buf.size();
+    write_compact(ctx, buf, hdr, source, dest, pw);
+  }
+  if (!hdl.is<connection_handle>())
+    return;
+  auto& chdl = get<connection_handle>(hdl);
+  if (fragment_size_ > 0
+      && (hdr.operation == message_type::dispatch_message
+          || hdr.operation == message_type::kill_proxy)
+      && schedule(ctx, chdl, hdr, buf, pos))
+    return;
+  add_written(chdl, buf.size() - before);
+}
+
+void instance::write_batch(execution_unit* ctx, const connection_handle& hdl,
+                           buffer_type& batch, buffer_type& out) {
+  CAF_LOG_TRACE(CAF_ARG(hdl) << CAF_ARG2("size", batch.size()));
+  auto ep = callee_.find_context(hdl);
+  auto peer = tbl_.lookup_direct(hdl);
+  if (codec_ == nullptr || ep == nullptr || peer == none
+      || batch.size() < compression_threshold_
+      || batch.size() > std::numeric_limits<uint32_t>::max()) {
+    out.insert(out.end(), batch.begin(), batch.end());
+    batch.clear();
+    return;
+  }
+  buffer_type data;
+  codec_->compress(batch.data(), batch.size(), data);
+  if (data.size() + sizeof(uint32_t) >= batch.size()) {
+    out.insert(out.end(), batch.begin(), batch.end());
+    batch.clear();
+    return;
+  }
+  auto size = static_cast<uint32_t>(batch.size());
+  auto writer = make_callback([&](serializer& sink) -> error {
+    auto err = sink(size);
+    if (err)
+      return err;
+    return sink.apply_raw(data.size(), data.data());
+  });
+  header hdr{message_type::compressed, 0, 0,
+             static_cast<uint64_t>(codec_->name()), this_node_, peer,
+             invalid_actor_id, invalid_actor_id};
+  if (ep->compact_headers)
+    write_compact(ctx, out, hdr, endpoint_alias, endpoint_alias, &writer);
+  else
+    write(ctx, out, hdr, &writer);
+  batch.clear();
+}
+
+bool instance::schedule(execution_unit* ctx, const connection_handle& hdl,
+                        header& hdr, buffer_type& buf, size_t pos) {
+  // Urgent messages may overtake regular messages, hence they share one flow
+  // with a higher weight. All other messages keep the order of their sender.
+  auto urgent = hdr.operation == message_type::dispatch_message
+                && make_message_id(hdr.operation_data).is_urgent_message();
+  auto key = urgent ? std::numeric_limits<fragment_scheduler::flow_key>::max()
+                    : fragment_scheduler::flow_key{hdr.source_actor};
+  size_t weight = urgent ? 4 : 1;
+  auto i = fragments_.find(hdl);
+  auto large = hdr.payload_len > fragment_size_;
+  if (!large && (i == fragments_.end() || !i->second.pending(key)))
+    return false;
+  CAF_LOG_DEBUG(CAF_ARG(hdl) << CAF_ARG(hdr) << CAF_ARG(large));
+  if (i == fragments_.end())
+    i = fragments_.emplace(hdl, fragment_scheduler{fragment_size_}).first;
+  auto& sched = i->second;
+  auto was_empty = sched.empty();
+  if (large) {
+    // Fragments carry the header in regular format, followed by the payload.
+    buffer_type data;
+    data.reserve(header_size + hdr.payload_len);
+    binary_serializer bs{ctx, data};
+    auto err = bs(hdr);
+    if (err)
+      CAF_LOG_ERROR(CAF_ARG(err));
+    data.insert(data.end(), buf.end() - hdr.payload_len, buf.end());
+    header fragment_hdr{message_type::fragment, 0, 0, next_fragment_id_++,
+                        hdr.source_node, hdr.dest_node,
+                        hdr.source_actor, hdr.dest_actor};
+    sched.push(key, weight, std::move(data), fragment_hdr);
+  } else {
+    sched.push(key, weight, buffer_type(buf.begin() + pos, buf.end()));
+  }
+  buf.resize(pos);
+  if (was_empty) {
+    tbl_.parent()->ack_writes(hdl, true);
+    write_fragments(ctx, hdl, sched);
+  }
+  // Queued fragments count towards the buffered bytes of the connection.
+  add_written(hdl, 0);
+  return true;
+}
+
+void instance::write_fragments(execution_unit* ctx,
+                               const connection_handle& hdl,
+                               fragment_scheduler& sched) {
+  CAF_LOG_TRACE(CAF_ARG(hdl) << CAF_ARG2("buffered", sched.buffered()));
+  auto& buf = callee_.get_buffer(hdl);
+  sched.round([&](header* hdr, const char* data, size_t size) {
+    if (hdr == nullptr) {
+      buf.insert(buf.end(), data, data + size);
+      add_written(hdl, size);
+      return;
+    }
+    auto writer = make_callback([&](serializer& sink) -> error {
+      return sink.apply_raw(size, const_cast<char*>(data));
+    });
+    write(ctx, hdl, *hdr, &writer);
+  });
+  callee_.flush(hdl);
+}
+
+void instance::add_written(const connection_handle& hdl, size_t n) {
+  if (high_watermark_ == 0)
+    return;
+  auto i = flows_.find(hdl);
+  if (i == flows_.end()) {
+    auto nid = tbl_.lookup_direct(hdl);
+    // Connections join flow control after completing the handshake.
+    if (nid == none)
+      return;
+    i = flows_.emplace(hdl, flow_state{nid, 0, false}).first;
+    tbl_.parent()->ack_writes(hdl, true);
+  }
+  i->second.bytes += n;
+  check_watermarks(hdl, i->second);
+}
+
+size_t instance::buffered_bytes(const connection_handle& hdl,
+                                const flow_state& st) const {
+  auto i = fragments_.find(hdl);
+  return st.bytes + (i != fragments_.end() ? i->second.buffered() : 0);
+}
+
+void instance::check_watermarks(const connection_handle& hdl,
+                                flow_state& st) {
+  auto bytes = buffered_bytes(hdl, st);
+  if (!st.congested && bytes >= high_watermark_) {
+    CAF_LOG_DEBUG("reached high watermark:" << CAF_ARG(hdl) << CAF_ARG(bytes));
+    st.congested = true;
+    auto i = gates_.find(st.peer);
+    if (i != gates_.end())
+      i->second->close();
+  } else if (st.congested && bytes <= low_watermark_) {
+    CAF_LOG_DEBUG("reached low watermark:" << CAF_ARG(hdl) << CAF_ARG(bytes));
+    st.congested = false;
+    auto i = gates_.find(st.peer);
+    if (i != gates_.end() && !congested(st.peer))
+      i->second->open();
+  }
+}
+
+bool instance::congested(const node_id& nid) const {
+  for (auto& kvp : flows_)
+    if (kvp.second.peer == nid && kvp.second.congested)
+      return true;
+  return false;
+}
+
 void instance::write_server_handshake(execution_unit* ctx,
                                       buffer_type& out_buf,
                                       optional<uint16_t> port,
@@ -377,7 +786,7 @@ void instance::write_server_handshake(execution_unit* ctx,
     std::set<std::string> tmp;
     return sink(aid, tmp);
   });
-  header hdr{message_type::server_handshake, 0, 0, version,
+  header hdr{message_type::server_handshake, handshake_flags(), 0, version,
              this_node_, none,
              (pa != nullptr) && pa->first ? pa->first->id() : invalid_actor_id,
              invalid_actor_id, sequence_number};
@@ -403,24 +812,35 @@ void instance::write_client_handshake(execution_unit* ctx,
 void instance::write_client_handshake(execution_unit* ctx,
                                       buffer_type& buf,
                                       const node_id& remote_side,
-                                      uint16_t sequence_number) {
-  write_client_handshake(ctx, buf, remote_side, this_node_,
-                         get_or(callee_.config(), "middleman.app-identifier",
-                                defaults::middleman::app_identifier),
-                         sequence_number);
+                                      uint16_t sequence_number, bool lane) {
+  CAF_LOG_TRACE(CAF_ARG(remote_side) << CAF_ARG(lane));
+  auto app_identifier = get_or(callee_.config(), "middleman.app-identifier",
+                               defaults::middleman::app_identifier);
+  auto writer = make_callback([&](serializer& sink) -> error {
+    return sink(app_identifier);
+  });
+  auto flags = handshake_flags();
+  if (lane)
+    flags |= header::lane_flag;
+  header hdr{message_type::client_handshake, flags, 0, 0,
+             this_node_, remote_side, invalid_actor_id, invalid_actor_id,
+             sequence_number};
+  write(ctx, buf, hdr, &writer);
 }
 
-void instance::write_announce_proxy(execution_unit* ctx, buffer_type& buf,
+void instance::write_announce_proxy(execution_unit* ctx,
+                                    const endpoint_handle& hdl,
                                     const node_id& dest_node, actor_id aid,
                                     uint16_t sequence_number) {
   CAF_LOG_TRACE(CAF_ARG(dest_node) << CAF_ARG(aid));
   header hdr{message_type::announce_proxy, 0, 0, 0,
              this_node_, dest_node, invalid_actor_id, aid,
              sequence_number};
-  write(ctx, buf, hdr);
+  write(ctx, hdl, hdr);
 }
 
-void instance::write_kill_proxy(execution_unit* ctx, buffer_type& buf,
+void instance::write_kill_proxy(execution_unit* ctx,
+                                const endpoint_handle& hdl,
                                 const node_id& dest_node, actor_id aid,
                                 const error& rsn, uint16_t sequence_number) {
   CAF_LOG_TRACE(CAF_ARG(dest_node) << CAF_ARG(aid) << CAF_ARG(rsn));
@@ -430,20 +850,159 @@ void instance::write_kill_proxy(execution_unit* ctx, buffer_type& buf,
   header hdr{message_type::kill_proxy, 0, 0, 0,
              this_node_, dest_node, aid, invalid_actor_id,
              sequence_number};
-  write(ctx, buf, hdr, &writer);
+  write(ctx, hdl, hdr, &writer);
 }
 
 void instance::write_heartbeat(execution_unit* ctx,
-                               buffer_type& buf,
+                               const endpoint_handle& hdl,
                                const node_id& remote_side,
                                uint16_t sequence_number) {
   CAF_LOG_TRACE(CAF_ARG(remote_side));
   header hdr{message_type::heartbeat, 0, 0, 0,
              this_node_, remote_side, invalid_actor_id, invalid_actor_id,
              sequence_number};
+  write(ctx, hdl, hdr);
+}
+
+void instance::write_ack(execution_unit* ctx, buffer_type& buf,
+                         const endpoint_context& ep,
+                         const node_id& remote_side) {
+  CAF_LOG_TRACE(CAF_ARG(remote_side) << CAF_ARG(ep.seq_incoming));
+  uint64_t sack = 0;
+  for (auto& kvp : ep.pending) {
+    auto offset = static_cast<sequence_type>(kvp.first - ep.seq_incoming - 1);
+    if (offset < sliding_window::max_window)
+      sack |= uint64_t{1} << offset;
+  }
+  header hdr{message_type::ack, 0, 0, sack,
+             this_node_, remote_side, invalid_actor_id, invalid_actor_id,
+             ep.seq_incoming};
   write(ctx, buf, hdr);
 }
 
+void instance::negotiate(const endpoint_handle& hdl, const header& hdr) {
+  auto ep = callee_.find_context(hdl);
+  if (ep == nullptr)
+    return;
+  ep->varint_encoding = varint_encoding_ && hdr.has(header::varint_flag);
+  // Compact headers rely on in-order delivery of all messages that follow
+  // the handshake, hence we only use them for connection-oriented transports.
+  ep->compact_headers = compact_headers_ && hdl.is<connection_handle>()
+                        && hdr.has(header::compact_header_flag);
+  ep->reliable = reliable_datagrams_ && hdl.is<datagram_handle>()
+                 && hdr.has(header::reliable_flag);
+  ep->compression = codec_ != nullptr && hdl.is<connection_handle>()
+                    && hdr.has(header::compression_flag);
+  CAF_LOG_DEBUG(CAF_ARG(hdr.source_node) << CAF_ARG(ep->varint_encoding)
+                << CAF_ARG(ep->compact_headers) << CAF_ARG(ep->reliable)
+                << CAF_ARG(ep->compression));
+}
+
+uint8_t instance::handshake_flags() const {
+  uint8_t result = 0;
+  if (varint_encoding_)
+    result |= header::varint_flag;
+  if (compact_headers_)
+    result |= header::compact_header_flag;
+  if (reliable_datagrams_)
+    result |= header::reliable_flag;
+  if (codec_ != nullptr)
+    result |= header::compression_flag;
+  return result;
+}
+
+uint8_t instance::payload_flags(const routing_table::route& r,
+                                const node_id& dest) {
+  // Only the next hop told us which encodings it understands. Hence, we can
+  // only use variable-length integers if the next hop is the final receiver.
+  if (r.next_hop != dest)
+    return 0;
+  auto ep = callee_.find_context(r.hdl);
+  return ep != nullptr && ep->varint_encoding ? header::varint_flag
+                                              : uint8_t{0};
+}
+
+alias_type instance::make_alias(execution_unit* ctx,
+                                const endpoint_handle& hdl,
+                                endpoint_context& ep, const node_id& nid,
+                                const node_id& endpoint) {
+  if (nid == none)
+    return none_alias;
+  if (nid == endpoint)
+    return endpoint_alias;
+  auto i = ep.out_aliases.find(nid);
+  if (i != ep.out_aliases.end())
+    return i->second;
+  auto alias = static_cast<alias_type>(ep.out_aliases.size() + 1);
+  CAF_ASSERT(alias != none_alias);
+  ep.out_aliases.emplace(nid, alias);
+  CAF_LOG_DEBUG("assign new alias:" << CAF_ARG(alias) << CAF_ARG(nid));
+  auto writer = make_callback([&](serializer& sink) -> error {
+    return sink(const_cast<node_id&>(nid));
+  });
+  header hdr{message_type::node_alias, 0, 0, alias,
+             this_node_, tbl_.lookup_direct(hdl),
+             invalid_actor_id, invalid_actor_id};
+  write_compact(ctx, callee_.get_buffer(hdl), hdr, endpoint_alias,
+                endpoint_alias, &writer);
+  return alias;
+}
+
+connection_state instance::drop(const connection_handle& hdl) {
+  auto cb = make_callback([&](const node_id& nid) -> error {
+    callee_.purge_state(nid);
+    return none;
+  });
+  tbl_.erase_direct(hdl, cb);
+  return close_connection;
+}
+
+bool instance::read_header(deserializer& source, const connection_handle& hdl,
+                           header& hdr) {
+  auto ep = callee_.find_context(hdl);
+  auto ok = ep != nullptr && ep->compact_headers
+            ? read_compact_header(source, hdl, *ep, hdr)
+            : !source(hdr);
+  if (!ok || !valid(hdr)) {
+    CAF_LOG_WARNING("received invalid header:" << CAF_ARG(hdr));
+    return false;
+  }
+  return true;
+}
+
+bool instance::read_compact_header(deserializer& source,
+                                   const endpoint_handle& hdl,
+                                   endpoint_context& ep, header& hdr) {
+  alias_type src;
+  alias_type dest;
+  auto e = source(hdr.operation, hdr.flags, hdr.sequence_number,
+                  hdr.payload_len, hdr.operation_data, src, dest,
+                  hdr.source_actor, hdr.dest_actor);
+  if (e)
+    return false;
+  auto resolve = [&](alias_type x, const node_id& endpoint, node_id& res) {
+    switch (x) {
+      case endpoint_alias:
+        res = endpoint;
+        return true;
+      case none_alias:
+        res = none;
+        return true;
+      default: {
+        auto i = ep.in_aliases.find(x);
+        if (i == ep.in_aliases.end()) {
+          CAF_LOG_WARNING("received unknown alias:" << CAF_ARG(x));
+          return false;
+        }
+        res = i->second;
+        return true;
+      }
+    }
+  };
+  return resolve(src, tbl_.lookup_direct(hdl), hdr.source_node)
+         && resolve(dest, this_node_, hdr.dest_node);
+}
+
 } // namespace basp
 } // namespace io
 } // namespace caf
@@ -0,0 +1,69 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+#include "caf/io/network/local_doorman_impl.hpp"
+
+#include <cstdio>
+#include <utility>
+
+#include "caf/logger.hpp"
+#include "caf/make_counted.hpp"
+
+#include "caf/io/network/local_scribe_impl.hpp"
+#include "caf/io/network/default_multiplexer.hpp"
+
+namespace caf {
+namespace io {
+namespace network {
+
+local_doorman_impl::local_doorman_impl(default_multiplexer& mx,
+                                       native_socket sockfd, std::string path,
+                                       uint16_t port)
+    : doorman_impl(mx, sockfd),
+      path_(std::move(path)),
+      port_(port) {
+  // nop
+}
+
+local_doorman_impl::~local_doorman_impl() {
+  CAF_LOG_DEBUG("remove socket file" << CAF_ARG(path_));
+  std::remove(path_.c_str());
+}
+
+bool local_doorman_impl::new_connection() {
+  CAF_LOG_TRACE("");
+  if (detached())
+    return false;
+  auto& dm = acceptor_.backend();
+  scribe_ptr sptr = make_counted<local_scribe_impl>(
+    dm, acceptor_.accepted_socket(), path_, port_);
+  auto hdl = sptr->hdl();
+  parent()->add_scribe(std::move(sptr));
+  return doorman::new_connection(&dm, hdl);
+}
+
+std::string local_doorman_impl::addr() const {
+  return path_;
+}
+
+uint16_t local_doorman_impl::port() const {
+  return port_;
+}
+
+} // namespace network
+} // namespace io
+} // namespace caf
@@ -0,0 +1,45 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+#include "caf/io/network/local_scribe_impl.hpp"
+
+#include <utility>
+
+namespace caf {
+namespace io {
+namespace network {
+
+local_scribe_impl::local_scribe_impl(default_multiplexer& mx,
+                                     native_socket sockfd, std::string path,
+                                     uint16_t port)
+    : scribe_impl(mx, sockfd),
+      path_(std::move(path)),
+      port_(port) {
+  // nop
+}
+
+std::string local_scribe_impl::addr() const {
+  return path_;
+}
+
+uint16_t local_scribe_impl::port() const {
+  return port_;
+}
+
+} // namespace network
+} // namespace io
+} // namespace caf
@@ -0,0 +1,157 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#include "caf/io/basp/lz_codec.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+namespace caf {
+namespace io {
+namespace basp {
+
+namespace {
+
+uint32_t read32(const char* x) {
+  uint32_t result;
+  memcpy(&result, x, sizeof(result));
+  return result;
+}
+
+// Appends `x` as sequence of bytes of 255 followed by the remainder.
+void write_length(buffer_type& out, size_t x) {
+  for (; x >= 255; x -= 255)
+    out.push_back(static_cast<char>(255));
+  out.push_back(static_cast<char>(x));
+}
+
+// Adds the additional bytes of a length field to `x`.
+bool read_length(const char*& first, const char* last, size_t& x) {
+  uint8_t byte;
+  do {
+    if (first == last)
+      return false;
+    byte = static_cast<uint8_t>(*first++);
+    x += byte;
+  } while (byte == 255);
+  return true;
+}
+
+void write_sequence(buffer_type& out, const char* literals, size_t num,
+                    size_t offset, size_t match_len) {
+  auto lit_nibble = std::min(num, size_t{15});
+  auto match_nibble = match_len > 0 ? std::min(match_len - lz_codec::min_match,
+                                               size_t{15})
+                                    : size_t{0};
+  out.push_back(static_cast<char>((lit_nibble << 4) | match_nibble));
+  if (lit_nibble == 15)
+    write_length(out, num - 15);
+  out.insert(out.end(), literals, literals + num);
+  if (match_len == 0)
+    return;
+  out.push_back(static_cast<char>(offset & 0xFF));
+  out.push_back(static_cast<char>(offset >> 8));
+  if (match_nibble == 15)
+    write_length(out, match_len - lz_codec::min_match - 15);
+}
+
+} // namespace <anonymous>
+
+lz_codec::lz_codec() : table_(size_t{1} << hash_bits) {
+  // nop
+}
+
+atom_value lz_codec::name() const {
+  return atom("lz");
+}
+
+void lz_codec::compress(const char* data, size_t size, buffer_type& out) {
+  // Worst case: one token plus length bytes for incompressible input.
+  out.reserve(out.size() + size + size / 255 + 16);
+  std::fill(table_.begin(), table_.end(), 0u);
+  auto hash = [](uint32_t x) {
+    return static_cast<uint32_t>(x * 2654435761u) >> (32 - hash_bits);
+  };
+  size_t anchor = 0;
+  size_t pos = 0;
+  // Positions are stored off by one to mark empty slots with 0.
+  while (size >= min_match && pos <= size - min_match) {
+    auto key = read32(data + pos);
+    auto& slot = table_[hash(key)];
+    auto candidate = static_cast<size_t>(slot);
+    slot = static_cast<uint32_t>(pos + 1);
+    if (candidate == 0 || pos + 1 - candidate > max_offset
+        || read32(data + candidate - 1) != key) {
+      ++pos;
+      continue;
+    }
+    auto match = candidate - 1;
+    auto len = min_match;
+    while (pos + len < size && data[match + len] == data[pos + len])
+      ++len;
+    write_sequence(out, data + anchor, pos - anchor, pos - match, len);
+    pos += len;
+    anchor = pos;
+  }
+  write_sequence(out, data + anchor, size - anchor, 0, 0);
+}
+
+bool lz_codec::decompress(const char* data, size_t len, size_t size,
+                          buffer_type& out) {
+  auto first = data;
+  auto last = data + len;
+  auto base = out.size();
+  out.reserve(base + size);
+  while (first != last) {
+    auto token = static_cast<uint8_t>(*first++);
+    size_t num = token >> 4;
+    if (num == 15 && !read_length(first, last, num))
+      return false;
+    if (static_cast<size_t>(last - first) < num
+        || out.size() - base + num > size)
+      return false;
+    out.insert(out.end(), first, first + num);
+    first += num;
+    // The last sequence ends after its literals.
+    if (first == last)
+      return out.size() - base == size;
+    if (last - first < 2)
+      return false;
+    auto offset = static_cast<size_t>(static_cast<uint8_t>(first[0]))
+                  | (static_cast<size_t>(static_cast<uint8_t>(first[1])) << 8);
+    first += 2;
+    size_t match_len = token & 0x0F;
+    if (match_len == 15 && !read_length(first, last, match_len))
+      return false;
+    match_len += min_match;
+    auto produced = out.size() - base;
+    if (offset == 0 || offset > produced || produced + match_len > size)
+      return false;
+    // Copy byte by byte, since matches may overlap with their own output.
+    auto src = out.size() - offset;
+    for (size_t i = 0; i < match_len; ++i)
+      out.push_back(out[src + i]);
+  }
+  // The input must end with a sequence without match.
+  return false;
+}
+
+} // namespace basp
+} // namespace io
+} // namespace caf
@@ -0,0 +1,148 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/io/basp/message_strand.hpp"
+
+#include "caf/actor_cast.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/binary_deserializer.hpp"
+#include "caf/logger.hpp"
+#include "caf/mailbox_element.hpp"
+#include "caf/scheduler/abstract_coordinator.hpp"
+
+#include "caf/detail/sync_request_bouncer.hpp"
+
+namespace caf {
+namespace io {
+namespace basp {
+
+message_strand::message_strand(actor_system& sys, strong_actor_ptr broker)
+    : system_(sys),
+      broker_(actor_cast<weak_actor_ptr>(broker)),
+      scheduled_(false) {
+  // nop
+}
+
+message_strand::~message_strand() {
+  // nop
+}
+
+void message_strand::push(job x) {
+  std::unique_lock<std::mutex> guard{mtx_};
+  jobs_.emplace_back(std::move(x));
+  if (!scheduled_) {
+    scheduled_ = true;
+    schedule();
+  }
+}
+
+bool message_strand::idle() {
+  std::unique_lock<std::mutex> guard{mtx_};
+  return !scheduled_;
+}
+
+void message_strand::unpark() {
+  parked_ = job{};
+  std::unique_lock<std::mutex> guard{mtx_};
+  if (jobs_.empty())
+    scheduled_ = false;
+  else
+    schedule();
+}
+
+resumable::subtype_t message_strand::subtype() const {
+  return resumable::function_object;
+}
+
+resumable::resume_result message_strand::resume(execution_unit* ctx,
+                                                size_t max_throughput) {
+  CAF_LOG_TRACE(CAF_ARG(max_throughput));
+  for (size_t i = 0; i < max_throughput; ++i) {
+    job x;
+    { // Lifetime scope of guard.
+      std::unique_lock<std::mutex> guard{mtx_};
+      if (jobs_.empty()) {
+        scheduled_ = false;
+        return resumable::done;
+      }
+      x = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+    if (x.hdr.operation == message_type::dispatch_message) {
+      // Workers have no proxy registry. Hence, deserializing fails with
+      // `no_proxy_registry` for messages with handles to remote actors.
+      message msg;
+      binary_deserializer source{ctx, x.payload};
+      source.varint_encoding(uses_varint_encoding(x.hdr));
+      // Call `load` directly, since applying the deserializer to a message
+      // discards errors.
+      auto err = msg.load(source);
+      auto mid = make_message_id(x.hdr.operation_data);
+      if (!err) {
+        // The broker intercepts link and unlink messages.
+        if (!msg.match_elements<atom_value, strong_actor_ptr>()) {
+          x.dest->enqueue(make_mailbox_element(std::move(x.src), mid,
+                                               std::move(x.stages),
+                                               std::move(msg)),
+                          ctx);
+          continue;
+        }
+      } else if (err != sec::no_proxy_registry) {
+        CAF_LOG_ERROR("failed to deserialize message:" << CAF_ARG(err));
+        if (mid.valid() && x.src) {
+          detail::sync_request_bouncer srb{err};
+          srb(x.src, mid);
+        }
+        continue;
+      }
+    }
+    // Only the broker can handle this job. We stay scheduled until the broker
+    // calls `unpark` in order to not deliver any subsequent message early.
+    auto broker = actor_cast<strong_actor_ptr>(broker_);
+    if (!broker) {
+      CAF_LOG_DEBUG("broker is gone, drop remaining messages");
+      std::unique_lock<std::mutex> guard{mtx_};
+      jobs_.clear();
+      scheduled_ = false;
+      return resumable::done;
+    }
+    parked_ = std::move(x);
+    broker->enqueue(nullptr, make_message_id(),
+                    make_message(message_strand_ptr{this}), ctx);
+    return resumable::awaiting_message;
+  }
+  return resumable::resume_later;
+}
+
+void message_strand::intrusive_ptr_add_ref_impl() {
+  ref();
+}
+
+void message_strand::intrusive_ptr_release_impl() {
+  deref();
+}
+
+void message_strand::schedule() {
+  // The scheduler takes ownership of one reference.
+  ref();
+  system_.scheduler().enqueue(this);
+}
+
+} // namespace basp
+} // namespace io
+} // namespace caf
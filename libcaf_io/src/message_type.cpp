@@ -32,7 +32,11 @@ const char* message_type_strings[] = {
   "dispatch_message",
   "announce_proxy_instance",
   "kill_proxy_instance",
-  "heartbeat"
+  "heartbeat",
+  "node_alias",
+  "fragment",
+  "ack",
+  "compressed"
 };
 
 } // namespace <anonymous>
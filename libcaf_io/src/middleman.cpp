@@ -49,6 +49,7 @@
 #include "caf/io/network/interfaces.hpp"
 #include "caf/io/network/test_multiplexer.hpp"
 #include "caf/io/network/default_multiplexer.hpp"
+#include "caf/io/network/uring_multiplexer.hpp"
 
 #include "caf/scheduler/abstract_coordinator.hpp"
 
@@ -79,10 +80,39 @@ public:
     return backend_;
   }
 
+  backend_pointer make_backend() override {
+    return backend_pointer{new T(&system())};
+  }
+
 private:
   T backend_;
 };
 
+// Runs `mpx` in a new thread and blocks until the thread is up and running.
+std::thread launch_multiplexer(actor_system& sys, network::multiplexer& mpx) {
+  std::atomic<bool> init_done{false};
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::thread result{[&] {
+    CAF_SET_LOGGER_SYS(&sys);
+    detail::set_thread_name("caf.multiplexer");
+    sys.thread_started();
+    CAF_LOG_TRACE("");
+    {
+      std::unique_lock<std::mutex> guard{mtx};
+      mpx.thread_id(std::this_thread::get_id());
+      init_done = true;
+      cv.notify_one();
+    }
+    mpx.run();
+    sys.thread_terminates();
+  }};
+  std::unique_lock<std::mutex> guard{mtx};
+  while (init_done == false)
+    cv.wait(guard);
+  return result;
+}
+
 } // namespace <anonymous>
 
 actor_system::module* middleman::make(actor_system& sys, detail::type_list<>) {
@@ -91,15 +121,37 @@ actor_system::module* middleman::make(actor_system& sys, detail::type_list<>) {
   switch (atom_uint(atm)) {
     case atom_uint(atom("testing")):
       return new mm_impl<network::test_multiplexer>(sys);
+#ifdef CAF_URING_MULTIPLEXER
+    case atom_uint(atom("uring")):
+      // Fall back to the default backend if the kernel refuses io_uring.
+      if (network::uring_multiplexer::available())
+        return new mm_impl<network::uring_multiplexer>(sys);
+      return new mm_impl<network::default_multiplexer>(sys);
+#endif // CAF_URING_MULTIPLEXER
     default:
       return new mm_impl<network::default_multiplexer>(sys);
   }
 }
 
-middleman::middleman(actor_system& sys) : system_(sys) {
+middleman::middleman(actor_system& sys)
+    : system_(sys),
+      buffers_(get_or(sys.config(), "middleman.buffer-pool-size",
+                      defaults::middleman::buffer_pool_size)),
+      next_shard_(0) {
   // nop
 }
 
+network::multiplexer& middleman::next_backend() {
+  if (shards_.empty())
+    return backend();
+  auto i = next_shard_++ % (shards_.size() + 1);
+  return i == 0 ? backend() : *shards_[i - 1];
+}
+
+middleman::backend_pointer middleman::make_backend() {
+  return nullptr;
+}
+
 expected<strong_actor_ptr> middleman::remote_spawn_impl(const node_id& nid,
                                                         std::string& name,
                                                         message& args,
@@ -306,11 +358,31 @@ strong_actor_ptr middleman::remote_lookup(atom_value name, const node_id& nid) {
   return result;
 }
 
+size_t middleman::buffered_bytes(const node_id& nid) {
+  CAF_LOG_TRACE(CAF_ARG(nid));
+  auto basp = named_broker<basp_broker>(atom("BASP"));
+  size_t result = 0;
+  scoped_actor self{system(), true};
+  self->request(basp, infinite, get_atom::value, pending_atom::value, nid)
+  .receive(
+    [&](size_t x) {
+      result = x;
+    },
+    [&](error&) {
+      // nop
+    }
+  );
+  return result;
+}
+
 void middleman::start() {
   CAF_LOG_TRACE("");
   // Create hooks.
   for (auto& f : system().config().hook_factories)
     hooks_.emplace_back(f(system_));
+  // Share buffers between all sockets of all multiplexers.
+  if (buffers_.enabled())
+    backend().buffers(&buffers_);
   // Launch backend.
   if (!get_or(config(), "middleman.manual-multiplexing", false))
     backend_supervisor_ = backend().make_supervisor();
@@ -319,26 +391,20 @@ void middleman::start() {
   // thread instead. Other backends can set `middleman_detach_multiplexer` to
   // false to suppress creation of the supervisor.
   if (backend_supervisor_ != nullptr) {
-    std::atomic<bool> init_done{false};
-    std::mutex mtx;
-    std::condition_variable cv;
-    thread_ = std::thread{[&,this] {
-      CAF_SET_LOGGER_SYS(&system());
-      detail::set_thread_name("caf.multiplexer");
-      system().thread_started();
-      CAF_LOG_TRACE("");
-      {
-        std::unique_lock<std::mutex> guard{mtx};
-        backend().thread_id(std::this_thread::get_id());
-        init_done = true;
-        cv.notify_one();
-      }
-      backend().run();
-      system().thread_terminates();
-    }};
-    std::unique_lock<std::mutex> guard{mtx};
-    while (init_done == false)
-      cv.wait(guard);
+    thread_ = launch_multiplexer(system(), backend());
+    // Launch additional multiplexers for brokers. BASP and all other named
+    // brokers stay on the default backend.
+    auto n = get_or(config(), "middleman.multiplexer-threads",
+                    defaults::middleman::multiplexer_threads);
+    for (size_t i = 1; i < n; ++i) {
+      auto ptr = make_backend();
+      if (ptr == nullptr)
+        break;
+      ptr->buffers(backend().buffers());
+      shard_supervisors_.emplace_back(ptr->make_supervisor());
+      shard_threads_.emplace_back(launch_multiplexer(system(), *ptr));
+      shards_.emplace_back(std::move(ptr));
+    }
   }
   // Spawn utility actors.
   auto basp = named_broker<basp_broker>(atom("BASP"));
@@ -367,6 +433,10 @@ void middleman::stop() {
     backend_supervisor_.reset();
     if (thread_.joinable())
       thread_.join();
+    shard_supervisors_.clear();
+    for (auto& t : shard_threads_)
+      if (t.joinable())
+        t.join();
   } else {
     while (backend().try_run_once())
       ; // nop
@@ -40,6 +40,23 @@
 namespace caf {
 namespace io {
 
+namespace {
+
+// Returns whether `host` refers to this host, i.e., whether we can reach a
+// node at `host` via Unix domain sockets.
+bool is_local_host(const std::string& host) {
+  if (host == "localhost")
+    return true;
+  auto addrs = network::interfaces::list_addresses();
+  for (auto& kvp : addrs)
+    for (auto& addr : kvp.second)
+      if (addr == host)
+        return true;
+  return false;
+}
+
+} // namespace <anonymous>
+
 middleman_actor_impl::middleman_actor_impl(actor_config& cfg,
                                            actor default_broker)
     : middleman_actor::base(cfg),
@@ -127,8 +144,13 @@ auto middleman_actor_impl::make_behavior() -> behavior_type {
         rps->emplace_back(std::move(rp));
         return get_delegated{};
       }
-      // connect to endpoint and initiate handhsake etc.
-      auto r = connect(key.first, port);
+      // connect to endpoint and initiate handhsake etc., preferring Unix
+      // domain sockets for nodes on this host
+      expected<scribe_ptr> r{sec::cannot_connect_to_node};
+      if (!local_socket_path(port).empty() && is_local_host(key.first))
+        r = connect_local(port);
+      if (!r)
+        r = connect(key.first, port);
       if (!r) {
         rp.deliver(std::move(r.error()));
         return get_delegated{};
@@ -270,6 +292,16 @@ middleman_actor_impl::put(uint16_t port, strong_actor_ptr& whom, mpi_set& sigs,
     return std::move(res.error());
   auto& ptr = *res;
   actual_port = ptr->port();
+  // offer a Unix domain socket for nodes on this host as well
+  if (!local_socket_path(actual_port).empty()) {
+    auto local = open_local(actual_port);
+    if (local)
+      anon_send(broker_, publish_atom::value, std::move(*local), actual_port,
+                whom, sigs);
+    else
+      CAF_LOG_WARNING("unable to open Unix domain socket:"
+                      << CAF_ARG2("error", local.error()));
+  }
   anon_send(broker_, publish_atom::value, std::move(ptr), actual_port,
             std::move(whom), std::move(sigs));
   return actual_port;
@@ -333,6 +365,26 @@ middleman_actor_impl::open(uint16_t port, const char* addr, bool reuse) {
   return system().middleman().backend().new_tcp_doorman(port, addr, reuse);
 }
 
+expected<scribe_ptr> middleman_actor_impl::connect_local(uint16_t port) {
+  return system().middleman().backend().new_local_scribe(
+    local_socket_path(port), port);
+}
+
+expected<doorman_ptr> middleman_actor_impl::open_local(uint16_t port) {
+  return system().middleman().backend().new_local_doorman(
+    local_socket_path(port), port);
+}
+
+std::string middleman_actor_impl::local_socket_path(uint16_t port) const {
+  auto dir = get_or(config(), "middleman.unix-socket-dir", "");
+  if (dir.empty())
+    return dir;
+  dir += "/caf-";
+  dir += std::to_string(port);
+  dir += ".sock";
+  return dir;
+}
+
 expected<datagram_servant_ptr>
 middleman_actor_impl::open_udp(uint16_t port, const char* addr, bool reuse) {
   return system().middleman().backend().new_local_udp_endpoint(port, addr,
@@ -17,6 +17,9 @@
  ******************************************************************************/
 
 #include "caf/io/network/multiplexer.hpp"
+
+#include "caf/sec.hpp"
+
 #include "caf/io/network/default_multiplexer.hpp" // default singleton
 
 namespace caf {
@@ -25,10 +28,21 @@ namespace network {
 
 multiplexer::multiplexer(actor_system* sys)
     : execution_unit(sys),
-      tid_(std::this_thread::get_id()) {
+      tid_(std::this_thread::get_id()),
+      buffers_(nullptr) {
   // nop
 }
 
+expected<scribe_ptr> multiplexer::new_local_scribe(const std::string& path,
+                                                   uint16_t) {
+  return make_error(sec::feature_disabled, "new_local_scribe", path);
+}
+
+expected<doorman_ptr> multiplexer::new_local_doorman(const std::string& path,
+                                                     uint16_t) {
+  return make_error(sec::feature_disabled, "new_local_doorman", path);
+}
+
 multiplexer_ptr multiplexer::make(actor_system& sys) {
   CAF_LOG_TRACE("");
   return multiplexer_ptr{new default_multiplexer(&sys)};
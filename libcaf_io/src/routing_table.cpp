@@ -18,6 +18,8 @@
 
 #include "caf/io/basp/routing_table.hpp"
 
+#include <algorithm>
+
 #include "caf/io/middleman.hpp"
 
 namespace caf {
@@ -52,6 +54,17 @@ optional<routing_table::route> routing_table::lookup(const node_id& target) {
   return none;
 }
 
+optional<routing_table::route> routing_table::lookup(const node_id& target,
+                                                     size_t key) {
+  auto res = lookup(target);
+  if (res) {
+    auto i = lanes_.find(res->next_hop);
+    if (i != lanes_.end())
+      res->hdl = i->second[key % i->second.size()];
+  }
+  return res;
+}
+
 node_id routing_table::lookup_direct(const endpoint_handle& hdl) const {
   return get_opt(direct_by_hdl_, hdl, none);
 }
@@ -88,6 +101,22 @@ void routing_table::erase_direct(const endpoint_handle& hdl,
   auto i = direct_by_hdl_.find(hdl);
   if (i == direct_by_hdl_.end())
     return;
+  auto j = lanes_.find(i->second);
+  if (j != lanes_.end()) {
+    auto& xs = j->second;
+    auto k = std::find(xs.begin(), xs.end(), hdl);
+    if (k != xs.end()) {
+      // The node remains reachable via its direct connection.
+      xs.erase(k);
+      if (xs.empty())
+        lanes_.erase(j);
+      direct_by_hdl_.erase(i);
+      return;
+    }
+    for (auto& x : xs)
+      direct_by_hdl_.erase(x);
+    lanes_.erase(j);
+  }
   cb(i->second);
   parent_->parent().notify<hook::connection_lost>(i->second);
   direct_by_nid_.erase(i->second);
@@ -114,6 +143,27 @@ void routing_table::add_direct(const endpoint_handle& hdl,
   parent_->parent().notify<hook::new_connection_established>(nid);
 }
 
+void routing_table::add_lane(const endpoint_handle& hdl,
+                             const node_id& nid) {
+  CAF_ASSERT(direct_by_hdl_.count(hdl) == 0);
+  CAF_ASSERT(direct_by_nid_.count(nid) == 1);
+  direct_by_hdl_.emplace(hdl, nid);
+  lanes_[nid].emplace_back(hdl);
+}
+
+std::vector<routing_table::endpoint_handle>
+routing_table::lanes(const node_id& nid) const {
+  auto i = lanes_.find(nid);
+  if (i != lanes_.end())
+    return i->second;
+  return {};
+}
+
+bool routing_table::is_lane(const endpoint_handle& hdl) const {
+  auto i = direct_by_hdl_.find(hdl);
+  return i != direct_by_hdl_.end() && direct_by_nid_.at(i->second) != hdl;
+}
+
 bool routing_table::add_indirect(const node_id& hop, const node_id& dest) {
   auto i = blacklist_.find(dest);
   if (i == blacklist_.end() || i->second.count(hop) == 0) {
@@ -144,6 +194,12 @@ size_t routing_table::erase(const node_id& dest, erase_callback& cb) {
   }
   auto hdl = lookup_direct(dest);
   if (hdl) {
+    auto j = lanes_.find(dest);
+    if (j != lanes_.end()) {
+      for (auto& x : j->second)
+        direct_by_hdl_.erase(x);
+      lanes_.erase(j);
+    }
     direct_by_hdl_.erase(*hdl);
     direct_by_nid_.erase(dest);
     parent_->parent().notify<hook::connection_lost>(dest);
@@ -0,0 +1,169 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+
+#include "caf/io/basp/sliding_window.hpp"
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace io {
+namespace basp {
+
+namespace {
+
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+constexpr milliseconds initial_rto = milliseconds(200);
+constexpr milliseconds min_rto = milliseconds(10);
+constexpr seconds max_rto = seconds(10);
+
+// Compares sequence numbers with wraparound.
+bool before(sequence_type x, sequence_type y) {
+  return static_cast<int16_t>(static_cast<sequence_type>(x - y)) < 0;
+}
+
+} // namespace <anonymous>
+
+sliding_window::sliding_window(size_t window_size)
+    : sent_(0),
+      window_size_(std::min(std::max(window_size, size_t{1}), max_window)),
+      cwnd_(std::min(initial_cwnd, window_size_)),
+      ssthresh_(window_size_),
+      acked_in_round_(0),
+      recovering_(false),
+      recovery_seq_(0),
+      has_rtt_(false),
+      srtt_(0),
+      rttvar_(0),
+      rto_(initial_rto),
+      retransmissions_(0) {
+  // nop
+}
+
+optional<sliding_window::time_point> sliding_window::deadline() const {
+  optional<time_point> result;
+  for (size_t i = 0; i < sent_; ++i) {
+    auto& e = entries_[i];
+    if (!e.acked && (!result || e.sent + rto_ < *result))
+      result = e.sent + rto_;
+  }
+  return result;
+}
+
+void sliding_window::handle_ack(sequence_type next, uint64_t sack,
+                                time_point now) {
+  for (size_t i = 0; i < sent_; ++i) {
+    auto& e = entries_[i];
+    if (e.acked)
+      continue;
+    if (before(e.seq, next)) {
+      acknowledge(e, now);
+    } else {
+      auto offset = static_cast<sequence_type>(e.seq - next - 1);
+      if (offset < max_window && (sack & (uint64_t{1} << offset)) != 0)
+        acknowledge(e, now);
+    }
+  }
+  while (sent_ > 0 && entries_.front().acked) {
+    entries_.pop_front();
+    --sent_;
+  }
+  if (recovering_ && !before(next, recovery_seq_))
+    recovering_ = false;
+  // Retransmit each hole that the receiver skipped at least `dup_threshold`
+  // times, i.e., acknowledged as many later datagrams.
+  size_t later = 0;
+  for (auto i = sent_; i > 0; --i) {
+    auto& e = entries_[i - 1];
+    if (e.acked) {
+      ++later;
+    } else if (later >= dup_threshold && !e.retransmitted && !e.resend) {
+      e.resend = true;
+      enter_recovery(false);
+    }
+  }
+}
+
+void sliding_window::handle_timeout(time_point now) {
+  auto timed_out = false;
+  for (size_t i = 0; i < sent_; ++i) {
+    auto& e = entries_[i];
+    if (!e.acked && e.sent + rto_ <= now) {
+      e.resend = true;
+      timed_out = true;
+    }
+  }
+  if (!timed_out)
+    return;
+  enter_recovery(true);
+  rto_ = std::min(rto_ * 2, duration_type{max_rto});
+}
+
+bool sliding_window::acknowledge(entry& e, time_point now) {
+  if (e.acked)
+    return false;
+  e.acked = true;
+  e.resend = false;
+  // Karn's algorithm: ambiguous samples from retransmitted datagrams would
+  // distort the estimation.
+  if (!e.retransmitted)
+    add_rtt_sample(now - e.sent);
+  if (cwnd_ < ssthresh_) {
+    ++cwnd_;
+  } else if (++acked_in_round_ >= cwnd_) {
+    acked_in_round_ = 0;
+    ++cwnd_;
+  }
+  cwnd_ = std::min(cwnd_, window_size_);
+  return true;
+}
+
+void sliding_window::add_rtt_sample(duration_type rtt) {
+  if (!has_rtt_) {
+    has_rtt_ = true;
+    srtt_ = rtt;
+    rttvar_ = rtt / 2;
+  } else {
+    auto delta = srtt_ > rtt ? srtt_ - rtt : rtt - srtt_;
+    rttvar_ = (rttvar_ * 3 + delta) / 4;
+    srtt_ = (srtt_ * 7 + rtt) / 8;
+  }
+  rto_ = srtt_ + std::max(duration_type{min_rto}, rttvar_ * 4);
+  rto_ = std::max(duration_type{min_rto}, std::min(rto_,
+                                                   duration_type{max_rto}));
+}
+
+void sliding_window::enter_recovery(bool timeout) {
+  // Reduce the window only once per round trip unless the retransmission
+  // timer fired.
+  if (recovering_ && !timeout)
+    return;
+  ssthresh_ = std::max(cwnd_ / 2, size_t{2});
+  cwnd_ = timeout ? 1 : ssthresh_;
+  acked_in_round_ = 0;
+  recovering_ = true;
+  recovery_seq_ = sent_ > 0 ? static_cast<sequence_type>(
+                                entries_[sent_ - 1].seq + 1)
+                            : 0;
+}
+
+} // namespace basp
+} // namespace io
+} // namespace caf
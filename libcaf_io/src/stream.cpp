@@ -30,6 +30,14 @@ namespace caf {
 namespace io {
 namespace network {
 
+namespace {
+
+// Minimum size of the read buffer in framed mode. Reading ahead this many
+// bytes allows us to receive many small frames with a single system call.
+constexpr size_t framed_read_size = 65536;
+
+} // namespace <anonymous>
+
 stream::stream(default_multiplexer& backend_ref, native_socket sockfd)
     : event_handler(backend_ref, sockfd),
       max_consecutive_reads_(
@@ -52,7 +60,17 @@ void stream::activate(stream_manager* mgr) {
   if (!reader_) {
     reader_.reset(mgr);
     event_handler::activate();
+    acquire_rd_buf();
     prepare_next_read();
+    // Data that arrived before passivating the stream (e.g. additional frames
+    // in framed mode) does not trigger another read event.
+    if (collected_ > 0 && collected_ >= read_threshold_) {
+      manager_ptr ptr{mgr};
+      backend().post([=] {
+        if (reader_ == ptr)
+          consume_buffered();
+      });
+    }
   }
 }
 
@@ -69,6 +87,8 @@ void stream::write(const void* buf, size_t num_bytes) {
   CAF_LOG_TRACE(CAF_ARG(num_bytes));
   auto first = reinterpret_cast<const char*>(buf);
   auto last  = first + num_bytes;
+  if (wr_offline_buf_.capacity() == 0)
+    acquire_wr_buf();
   wr_offline_buf_.insert(wr_offline_buf_.end(), first, last);
 }
 
@@ -107,29 +127,105 @@ void stream::force_empty_write(const manager_ptr& mgr) {
 }
 
 void stream::prepare_next_read() {
-  collected_ = 0;
   switch (rd_flag_) {
     case receive_policy_flag::exactly:
       if (rd_buf_.size() != max_)
-        rd_buf_.resize(max_);
+        rd_buf_.resize(std::max(max_, collected_));
       read_threshold_ = max_;
       break;
     case receive_policy_flag::at_most:
       if (rd_buf_.size() != max_)
-        rd_buf_.resize(max_);
+        rd_buf_.resize(std::max(max_, collected_));
       read_threshold_ = 1;
       break;
     case receive_policy_flag::at_least: {
       // read up to 10% more, but at least allow 100 bytes more
       auto max_size = max_ + std::max<size_t>(100, max_ / 10);
       if (rd_buf_.size() != max_size)
-        rd_buf_.resize(max_size);
+        rd_buf_.resize(std::max(max_size, collected_));
       read_threshold_ = max_;
       break;
     }
+    case receive_policy_flag::framed: {
+      // wait for the header of the next frame, then for its remainder
+      receive_policy::config cfg{rd_flag_, max_};
+      auto hsize = receive_policy::frame_header_size(cfg);
+      read_threshold_ = collected_ < hsize
+                        ? hsize
+                        : receive_policy::frame_size(cfg, rd_buf_.data());
+      auto size = std::max(framed_read_size, read_threshold_);
+      if (rd_buf_.size() != size)
+        rd_buf_.resize(std::max(size, collected_));
+      break;
+    }
   }
 }
 
+void stream::acquire_rd_buf() {
+  auto pool = backend().buffers();
+  if (pool == nullptr || rd_buf_.capacity() > 0)
+    return;
+  // Ask for the largest size `prepare_next_read` picks for the policy.
+  auto size = rd_flag_ == receive_policy_flag::framed
+              ? framed_read_size
+              : max_ + std::max<size_t>(100, max_ / 10);
+  pool->acquire(rd_buf_, size);
+}
+
+void stream::release_rd_buf() {
+  auto pool = backend().buffers();
+  if (pool == nullptr || collected_ > 0)
+    return;
+  pool->release(rd_buf_);
+  pool->release(rd_tail_);
+}
+
+void stream::acquire_wr_buf() {
+  auto pool = backend().buffers();
+  if (pool != nullptr)
+    pool->acquire(wr_offline_buf_, 0);
+}
+
+bool stream::consume_buffered() {
+  while (collected_ >= read_threshold_) {
+    size_t num_bytes;
+    switch (rd_flag_) {
+      case receive_policy_flag::exactly:
+        num_bytes = max_;
+        break;
+      case receive_policy_flag::at_most:
+        num_bytes = std::min(collected_, max_);
+        break;
+      case receive_policy_flag::at_least:
+        num_bytes = collected_;
+        break;
+      default:
+        num_bytes = receive_policy::complete_frames({rd_flag_, max_},
+                                                    rd_buf_.data(),
+                                                    collected_);
+    }
+    // The manager may swap or shrink the read buffer, hence we move all bytes
+    // for the next delivery out of the way first.
+    auto remainder = collected_ - num_bytes;
+    if (remainder > 0)
+      rd_tail_.assign(rd_buf_.begin() + static_cast<ptrdiff_t>(num_bytes),
+                      rd_buf_.begin() + static_cast<ptrdiff_t>(collected_));
+    auto res = reader_->consume(&backend(), rd_buf_.data(), num_bytes);
+    collected_ = remainder;
+    if (remainder > 0) {
+      if (rd_buf_.size() < remainder)
+        rd_buf_.resize(remainder);
+      std::copy(rd_tail_.begin(), rd_tail_.end(), rd_buf_.begin());
+    }
+    prepare_next_read();
+    if (!res) {
+      passivate();
+      return false;
+    }
+  }
+  return true;
+}
+
 void stream::prepare_next_write() {
   CAF_LOG_TRACE(CAF_ARG(wr_buf_.size()) << CAF_ARG(wr_offline_buf_.size()));
   written_ = 0;
@@ -137,6 +233,12 @@ void stream::prepare_next_write() {
   if (wr_offline_buf_.empty()) {
     writing_ = false;
     backend().del(operation::write, fd(), this);
+    // Return both buffers to the pool until the next write.
+    auto pool = backend().buffers();
+    if (pool != nullptr) {
+      pool->release(wr_buf_);
+      pool->release(wr_offline_buf_);
+    }
   } else {
     wr_buf_.swap(wr_offline_buf_);
   }
@@ -149,20 +251,17 @@ bool stream::handle_read_result(rw_state read_result, size_t rb) {
       passivate();
       return false;
     case rw_state::indeterminate:
+      // The socket has no more data for now.
+      release_rd_buf();
       return false;
     case rw_state::success:
       if (rb == 0)
         return false;
       collected_ += rb;
-      if (collected_ >= read_threshold_) {
-        auto res = reader_->consume(&backend(), rd_buf_.data(),
-                                    collected_);
+      if (collected_ >= read_threshold_)
+        return consume_buffered();
+      if (rd_flag_ == receive_policy_flag::framed)
         prepare_next_read();
-        if (!res) {
-          passivate();
-          return false;
-        }
-      }
       break;
   }
   return true;
@@ -179,6 +278,12 @@ void stream::handle_write_result(rw_state write_result, size_t wb) {
       break;
     case rw_state::success:
       written_ += wb;
+      if (written_ > wr_buf_.size()) {
+        // A gather write also consumed parts of the offline buffer.
+        written_ -= wr_buf_.size();
+        wr_buf_.clear();
+        wr_buf_.swap(wr_offline_buf_);
+      }
       CAF_ASSERT(written_ <= wr_buf_.size());
       auto remaining = wr_buf_.size() - written_;
       if (ack_writes_)
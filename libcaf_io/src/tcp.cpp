@@ -25,6 +25,7 @@
 #ifdef CAF_WINDOWS
 # include <winsock2.h>
 #else
+# include <sys/uio.h>
 # include <sys/types.h>
 # include <sys/socket.h>
 #endif
@@ -64,6 +65,39 @@ rw_state tcp::write_some(size_t& result, native_socket fd, const void* buf,
   return rw_state::success;
 }
 
+rw_state tcp::write_some(size_t& result, native_socket fd, const void* buf1,
+                         size_t len1, const void* buf2, size_t len2) {
+  CAF_LOG_TRACE(CAF_ARG(fd) << CAF_ARG(len1) << CAF_ARG(len2));
+# ifdef CAF_WINDOWS
+  WSABUF bufs[2];
+  bufs[0].buf = const_cast<char*>(reinterpret_cast<const char*>(buf1));
+  bufs[0].len = static_cast<ULONG>(len1);
+  bufs[1].buf = const_cast<char*>(reinterpret_cast<const char*>(buf2));
+  bufs[1].len = static_cast<ULONG>(len2);
+  DWORD bytes_sent = 0;
+  auto sres = ::WSASend(fd, bufs, 2, &bytes_sent, 0, nullptr, nullptr) == 0
+              ? static_cast<io::network::signed_size_type>(bytes_sent)
+              : io::network::signed_size_type{-1};
+# else
+  iovec bufs[2];
+  bufs[0].iov_base = const_cast<void*>(buf1);
+  bufs[0].iov_len = len1;
+  bufs[1].iov_base = const_cast<void*>(buf2);
+  bufs[1].iov_len = len2;
+  msghdr msg;
+  std::memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = bufs;
+  msg.msg_iovlen = 2;
+  auto sres = ::sendmsg(fd, &msg, no_sigpipe_io_flag);
+# endif
+  CAF_LOG_DEBUG(CAF_ARG(len1) << CAF_ARG(len2) << CAF_ARG(fd)
+                << CAF_ARG(sres));
+  if (is_error(sres, true))
+    return rw_state::failure;
+  result = (sres > 0) ? static_cast<size_t>(sres) : 0;
+  return rw_state::success;
+}
+
 bool tcp::try_accept(native_socket& result, native_socket fd) {
   using namespace io::network;
   CAF_LOG_TRACE(CAF_ARG(fd));
@@ -792,7 +792,7 @@ bool test_multiplexer::try_read_data(connection_handle hdl) {
         return true;
       }
       break;
-    case receive_policy_flag::at_most:
+    case receive_policy_flag::at_most: {
       auto max_bytes = static_cast<ptrdiff_t>(sd.recv_conf.second);
       if (!sd.vn_buf.empty()) {
         sd.rd_buf.clear();
@@ -806,6 +806,22 @@ bool test_multiplexer::try_read_data(connection_handle hdl) {
           sd.passive_mode = true;
         return true;
       }
+      break;
+    }
+    case receive_policy_flag::framed:
+      auto num_bytes = receive_policy::complete_frames(sd.recv_conf,
+                                                       sd.vn_buf.data(),
+                                                       sd.vn_buf.size());
+      if (num_bytes > 0) {
+        sd.rd_buf.clear();
+        auto first = sd.vn_buf.begin();
+        auto last = first + static_cast<ptrdiff_t>(num_bytes);
+        sd.rd_buf.insert(sd.rd_buf.end(), first, last);
+        sd.vn_buf.erase(first, last);
+        if (!sd.ptr->consume(this, sd.rd_buf.data(), sd.rd_buf.size()))
+          sd.passive_mode = true;
+        return true;
+      }
   }
   return false;
 }
@@ -866,7 +882,7 @@ bool test_multiplexer::read_data(connection_handle hdl) {
           return hits > 0;
         }
         break;
-      case receive_policy_flag::at_most:
+      case receive_policy_flag::at_most: {
         auto max_bytes = static_cast<ptrdiff_t>(sd.recv_conf.second);
         if (!sd.vn_buf.empty()) {
           ++hits;
@@ -882,6 +898,24 @@ bool test_multiplexer::read_data(connection_handle hdl) {
         } else {
           return hits > 0;
         }
+        break;
+      }
+      case receive_policy_flag::framed:
+        auto num_bytes = receive_policy::complete_frames(sd.recv_conf,
+                                                         sd.vn_buf.data(),
+                                                         sd.vn_buf.size());
+        if (num_bytes > 0) {
+          ++hits;
+          sd.rd_buf.clear();
+          auto first = sd.vn_buf.begin();
+          auto last = first + static_cast<ptrdiff_t>(num_bytes);
+          sd.rd_buf.insert(sd.rd_buf.end(), first, last);
+          sd.vn_buf.erase(first, last);
+          if (!sd.ptr->consume(this, sd.rd_buf.data(), sd.rd_buf.size()))
+            passive_mode(hdl) = true;
+        } else {
+          return hits > 0;
+        }
     }
   }
 }
@@ -18,6 +18,8 @@
 
 #include "caf/policy/udp.hpp"
 
+#include <algorithm>
+
 #include "caf/logger.hpp"
 
 #ifdef CAF_WINDOWS
@@ -71,5 +73,105 @@ bool udp::write_datagram(size_t& result, native_socket fd, void* buf,
   return true;
 }
 
+#ifdef CAF_LINUX
+
+bool udp::read_datagrams(size_t& result, native_socket fd,
+                         io::network::receive_buffer* bufs, size_t* sizes,
+                         ip_endpoint* eps, size_t num) {
+  CAF_LOG_TRACE(CAF_ARG(fd) << CAF_ARG(num));
+  num = std::min(num, max_batch_size);
+  mmsghdr msgs[max_batch_size];
+  iovec iovs[max_batch_size];
+  for (size_t i = 0; i < num; ++i) {
+    iovs[i].iov_base = bufs[i].data();
+    iovs[i].iov_len = bufs[i].size();
+    memset(eps[i].address(), 0, sizeof(sockaddr_storage));
+    auto& hdr = msgs[i].msg_hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.msg_name = eps[i].address();
+    hdr.msg_namelen = sizeof(sockaddr_storage);
+    hdr.msg_iov = &iovs[i];
+    hdr.msg_iovlen = 1;
+  }
+  auto sres = ::recvmmsg(fd, msgs, static_cast<unsigned>(num), 0, nullptr);
+  if (is_error(sres, true)) {
+    CAF_LOG_ERROR("recvmmsg returned" << CAF_ARG(sres));
+    return false;
+  }
+  result = (sres > 0) ? static_cast<size_t>(sres) : 0;
+  for (size_t i = 0; i < result; ++i) {
+    CAF_LOG_WARNING_IF((msgs[i].msg_hdr.msg_flags & MSG_TRUNC) != 0,
+                       "recvmmsg cut of message, only received "
+                       << CAF_ARG(bufs[i].size()) << " bytes");
+    sizes[i] = msgs[i].msg_len;
+    *eps[i].length() = static_cast<size_t>(msgs[i].msg_hdr.msg_namelen);
+  }
+  return true;
+}
+
+bool udp::write_datagrams(size_t& result, native_socket fd,
+                          const std::vector<char>* const* bufs,
+                          const ip_endpoint* const* eps, size_t num) {
+  CAF_LOG_TRACE(CAF_ARG(fd) << CAF_ARG(num));
+  num = std::min(num, max_batch_size);
+  mmsghdr msgs[max_batch_size];
+  iovec iovs[max_batch_size];
+  for (size_t i = 0; i < num; ++i) {
+    iovs[i].iov_base = const_cast<char*>(bufs[i]->data());
+    iovs[i].iov_len = bufs[i]->size();
+    auto& hdr = msgs[i].msg_hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.msg_name = const_cast<sockaddr*>(eps[i]->caddress());
+    hdr.msg_namelen = static_cast<socklen_t>(*eps[i]->clength());
+    hdr.msg_iov = &iovs[i];
+    hdr.msg_iovlen = 1;
+  }
+  auto sres = ::sendmmsg(fd, msgs, static_cast<unsigned>(num), 0);
+  if (is_error(sres, true)) {
+    CAF_LOG_ERROR("sendmmsg returned" << CAF_ARG(sres));
+    return false;
+  }
+  result = (sres > 0) ? static_cast<size_t>(sres) : 0;
+  return true;
+}
+
+#else // CAF_LINUX
+
+bool udp::read_datagrams(size_t& result, native_socket fd,
+                         io::network::receive_buffer* bufs, size_t* sizes,
+                         ip_endpoint* eps, size_t num) {
+  // Fall back to one system call per datagram, stopping at the first read
+  // that would block.
+  result = 0;
+  for (size_t i = 0; i < num; ++i) {
+    size_t len = 0;
+    if (!read_datagram(len, fd, bufs[i].data(), bufs[i].size(), eps[i]))
+      return false;
+    if (len == 0)
+      break;
+    sizes[i] = len;
+    ++result;
+  }
+  return true;
+}
+
+bool udp::write_datagrams(size_t& result, native_socket fd,
+                          const std::vector<char>* const* bufs,
+                          const ip_endpoint* const* eps, size_t num) {
+  result = 0;
+  for (size_t i = 0; i < num; ++i) {
+    size_t len = 0;
+    auto buf = const_cast<char*>(bufs[i]->data());
+    if (!write_datagram(len, fd, buf, bufs[i]->size(), *eps[i]))
+      return false;
+    if (len == 0 && !bufs[i]->empty())
+      break;
+    ++result;
+  }
+  return true;
+}
+
+#endif // CAF_LINUX
+
 } // namespace policy
 } // namespace caf
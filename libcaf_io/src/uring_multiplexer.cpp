@@ -0,0 +1,314 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/io/network/uring_multiplexer.hpp"
+
+#ifdef CAF_URING_MULTIPLEXER
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "caf/logger.hpp"
+
+namespace caf {
+namespace io {
+namespace network {
+
+namespace {
+
+// Each loop iteration submits at most one entry per socket, larger batches
+// simply flush the submission queue early.
+constexpr unsigned ring_size = 256;
+
+int io_uring_setup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                   unsigned flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                  min_complete, flags, nullptr, 0));
+}
+
+template <class T>
+T* ring_member(void* base, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+} // namespace <anonymous>
+
+uring_multiplexer::uring_multiplexer(actor_system* sys)
+    : default_multiplexer(sys),
+      ring_fd_(-1),
+      sq_ptr_(MAP_FAILED),
+      sq_len_(0),
+      cq_ptr_(MAP_FAILED),
+      cq_len_(0),
+      sqes_(nullptr),
+      sqes_len_(0),
+      pending_(0),
+      next_generation_(0) {
+  // We never wait on the epoll instance of our base type.
+  close_socket(epollfd_);
+  epollfd_ = invalid_native_socket;
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring_fd_ = io_uring_setup(ring_size, &params);
+  if (ring_fd_ < 0) {
+    CAF_LOG_ERROR("io_uring_setup: " << strerror(errno));
+    perror("io_uring_setup() failed");
+    CAF_CRITICAL("io_uring_setup() failed");
+  }
+  sq_len_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_len_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  auto single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap)
+    sq_len_ = cq_len_ = std::max(sq_len_, cq_len_);
+  sq_ptr_ = mmap(nullptr, sq_len_, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  cq_ptr_ = single_mmap ? sq_ptr_
+                        : mmap(nullptr, cq_len_, PROT_READ | PROT_WRITE,
+                               MAP_SHARED | MAP_POPULATE, ring_fd_,
+                               IORING_OFF_CQ_RING);
+  sqes_len_ = params.sq_entries * sizeof(io_uring_sqe);
+  auto sqes = mmap(nullptr, sqes_len_, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sq_ptr_ == MAP_FAILED || cq_ptr_ == MAP_FAILED || sqes == MAP_FAILED) {
+    CAF_LOG_ERROR("mmap: " << strerror(errno));
+    perror("mmap() failed");
+    CAF_CRITICAL("mmap() failed");
+  }
+  sqes_ = static_cast<io_uring_sqe*>(sqes);
+  sq_head_ = ring_member<unsigned>(sq_ptr_, params.sq_off.head);
+  sq_tail_ = ring_member<unsigned>(sq_ptr_, params.sq_off.tail);
+  sq_mask_ = ring_member<unsigned>(sq_ptr_, params.sq_off.ring_mask);
+  sq_array_ = ring_member<unsigned>(sq_ptr_, params.sq_off.array);
+  sq_entries_ = params.sq_entries;
+  cq_head_ = ring_member<unsigned>(cq_ptr_, params.cq_off.head);
+  cq_tail_ = ring_member<unsigned>(cq_ptr_, params.cq_off.tail);
+  cq_mask_ = ring_member<unsigned>(cq_ptr_, params.cq_off.ring_mask);
+  cqes_ = ring_member<io_uring_cqe>(cq_ptr_, params.cq_off.cqes);
+  // Our base type already counts the pipe in `shadow_`.
+  auto& x = registrations_[pipe_.first];
+  x = registration{&pipe_reader_, input_mask, next_generation_++, false};
+  arm(pipe_.first, x);
+}
+
+uring_multiplexer::~uring_multiplexer() {
+  if (sqes_ != nullptr)
+    munmap(sqes_, sqes_len_);
+  if (cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_)
+    munmap(cq_ptr_, cq_len_);
+  if (sq_ptr_ != MAP_FAILED)
+    munmap(sq_ptr_, sq_len_);
+  if (ring_fd_ >= 0)
+    close(ring_fd_);
+}
+
+bool uring_multiplexer::available() {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  auto fd = io_uring_setup(1, &params);
+  if (fd < 0)
+    return false;
+  close(fd);
+  return true;
+}
+
+bool uring_multiplexer::poll_once_impl(bool block) {
+  CAF_LOG_TRACE("io_uring-based multiplexer");
+  CAF_ASSERT(block == false || internally_posted_.empty());
+  // Submit all registration changes and wait for events with one system call.
+  if (block || pending_ > 0)
+    enter(block ? 1 : 0);
+  auto head = *cq_head_;
+  auto tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  CAF_LOG_DEBUG("io_uring on" << shadow_ << "sockets reported"
+                << (tail - head) << "completion(s)");
+  if (head == tail)
+    return false;
+  for (; head != tail; ++head) {
+    auto& cqe = cqes_[head & *cq_mask_];
+    // Completions for removals have no user data, completions for canceled
+    // or otherwise outdated polls have a mismatching generation.
+    if (cqe.user_data == 0)
+      continue;
+    auto fd = static_cast<native_socket>((cqe.user_data >> 32) - 1);
+    auto i = registrations_.find(fd);
+    if (i == registrations_.end() || !i->second.armed
+        || user_data(fd, i->second) != cqe.user_data)
+      continue;
+    auto& x = i->second;
+    x.armed = false;
+    fired_.emplace_back(fd);
+    // Report closed or otherwise invalid sockets as errors.
+    auto mask = cqe.res;
+    if (mask < 0 || (mask & POLLNVAL) != 0)
+      mask = error_mask;
+    handle_socket_event(fd, mask, x.ptr);
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  handle_internal_events();
+  // Polls are one-shot in order to keep the level-triggered semantics of
+  // epoll, i.e., re-arming reports sockets with remaining data immediately.
+  for (auto fd : fired_) {
+    auto i = registrations_.find(fd);
+    if (i != registrations_.end() && !i->second.armed)
+      arm(fd, i->second);
+  }
+  fired_.clear();
+  return true;
+}
+
+void uring_multiplexer::handle(const event& e) {
+  CAF_LOG_TRACE("e.fd = " << CAF_ARG(e.fd) << ", mask = "
+                << CAF_ARG(e.mask));
+  // ptr is only allowed to nullptr if fd is our pipe
+  // read handle which is only registered for input
+  CAF_ASSERT(e.ptr != nullptr || e.fd == pipe_.first);
+  if (e.ptr && e.ptr->eventbf() == e.mask)
+    return;
+  auto old = e.ptr ? e.ptr->eventbf() : input_mask;
+  if (e.ptr)
+    e.ptr->eventbf(e.mask);
+  auto i = registrations_.find(e.fd);
+  if (e.mask == 0) {
+    CAF_LOG_DEBUG("remove socket " << CAF_ARG(e.fd) << " from io_uring");
+    if (i == registrations_.end()) {
+      CAF_LOG_ERROR("cannot delete file descriptor "
+                    "because it isn't registered");
+    } else {
+      if (i->second.armed)
+        disarm(e.fd, i->second);
+      registrations_.erase(i);
+      --shadow_;
+    }
+  } else if (old == 0) {
+    CAF_LOG_DEBUG("add socket " << CAF_ARG(e.fd) << " to io_uring");
+    if (i != registrations_.end()) {
+      CAF_LOG_ERROR("file descriptor registered twice");
+    } else {
+      auto& x = registrations_[e.fd];
+      x = registration{e.ptr, e.mask, next_generation_++, false};
+      arm(e.fd, x);
+      ++shadow_;
+    }
+  } else if (i != registrations_.end()) {
+    CAF_LOG_DEBUG("modify io_uring event mask for socket " << CAF_ARG(e.fd)
+                  << ": " << CAF_ARG(old) << " -> " << CAF_ARG(e.mask));
+    auto& x = i->second;
+    x.mask = e.mask;
+    // Sockets without pending poll get re-armed after handling all events.
+    if (x.armed) {
+      disarm(e.fd, x);
+      x.generation = next_generation_++;
+      arm(e.fd, x);
+    }
+  }
+  if (e.ptr) {
+    auto remove_from_loop_if_needed = [&](int flag, operation flag_op) {
+      if ((old & flag) && !(e.mask & flag)) {
+        e.ptr->removed_from_loop(flag_op);
+      }
+    };
+    remove_from_loop_if_needed(input_mask, operation::read);
+    remove_from_loop_if_needed(output_mask, operation::write);
+  }
+}
+
+uint64_t uring_multiplexer::user_data(native_socket fd,
+                                      const registration& x) {
+  // Shift the file descriptor by one to never produce 0.
+  return (static_cast<uint64_t>(fd + 1) << 32) | x.generation;
+}
+
+io_uring_sqe* uring_multiplexer::next_sqe() {
+  auto tail = *sq_tail_;
+  if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) == sq_entries_) {
+    enter(0);
+    tail = *sq_tail_;
+  }
+  auto index = tail & *sq_mask_;
+  auto sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(io_uring_sqe));
+  sq_array_[index] = index;
+  // The kernel reads entries only during io_uring_enter, because we do not
+  // use a kernel-side polling thread. Hence, we can publish the entry early.
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  ++pending_;
+  return sqe;
+}
+
+void uring_multiplexer::arm(native_socket fd, registration& x) {
+  auto sqe = next_sqe();
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+  auto events = static_cast<uint32_t>(x.mask);
+# if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  events = (events << 16) | (events >> 16);
+# endif
+  sqe->poll32_events = events;
+  sqe->user_data = user_data(fd, x);
+  x.armed = true;
+}
+
+void uring_multiplexer::disarm(native_socket fd, registration& x) {
+  auto sqe = next_sqe();
+  sqe->opcode = IORING_OP_POLL_REMOVE;
+  sqe->fd = -1;
+  sqe->addr = user_data(fd, x);
+  sqe->user_data = 0;
+  x.armed = false;
+}
+
+void uring_multiplexer::enter(unsigned min_complete) {
+  auto flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0u;
+  // Keep running in case of `EINTR`.
+  for (;;) {
+    auto res = io_uring_enter(ring_fd_, pending_, min_complete, flags);
+    if (res < 0) {
+      switch (errno) {
+        case EINTR:
+          // a signal was caught, just try again
+          continue;
+        case EAGAIN:
+        case EBUSY:
+          // the completion queue is full, handle events first
+          return;
+        default:
+          perror("io_uring_enter() failed");
+          CAF_CRITICAL("io_uring_enter() failed");
+      }
+    }
+    pending_ -= std::min(pending_, static_cast<unsigned>(res));
+    return;
+  }
+}
+
+} // namespace network
+} // namespace io
+} // namespace caf
+
+#endif // CAF_URING_MULTIPLEXER
@@ -122,9 +122,13 @@ struct node {
 
 class fixture {
 public:
-  fixture(bool autoconn = false)
+  fixture(bool autoconn = false, bool compact = false, bool parallel = false,
+          bool framed = false)
       : sys(cfg.load<io::middleman, network::test_multiplexer>()
                   .set("middleman.enable-automatic-connections", autoconn)
+                  .set("middleman.enable-compact-headers", compact)
+                  .set("middleman.enable-parallel-deserialization", parallel)
+                  .set("middleman.enable-framed-reads", framed)
                   .set("scheduler.policy", autoconn ? caf::atom("testing")
                                                     : caf::atom("stealing"))
                   .set("middleman.attach-utility-actors", autoconn)) {
@@ -473,6 +477,71 @@ public:
   }
 };
 
+class compact_headers_fixture : public fixture {
+public:
+  compact_headers_fixture() : fixture(false, true) {
+    // nop
+  }
+
+  struct compact_message {
+    basp::header hdr;
+    basp::alias_type source;
+    basp::alias_type dest;
+    buffer payload;
+  };
+
+  template <class... Ts>
+  void compact_send(connection_handle hdl, basp::message_type operation,
+                    uint64_t operation_data, basp::alias_type source,
+                    basp::alias_type dest, actor_id source_actor,
+                    actor_id dest_actor, const Ts&... xs) {
+    buffer payload;
+    to_payload(payload, xs...);
+    buffer buf;
+    binary_serializer bs{mpx(), buf};
+    uint8_t flags = 0;
+    uint16_t sequence_number = 0;
+    auto payload_len = static_cast<uint32_t>(payload.size());
+    bs(operation, flags, sequence_number, payload_len, operation_data,
+       source, dest, source_actor, dest_actor);
+    CAF_REQUIRE_EQUAL(buf.size(), basp::compact_header_size);
+    buf.insert(buf.end(), payload.begin(), payload.end());
+    mpx()->virtual_send(hdl, buf);
+  }
+
+  compact_message compact_receive(connection_handle hdl) {
+    compact_message result;
+    auto& ob = mpx()->output_buffer(hdl);
+    while (ob.size() < basp::compact_header_size)
+      mpx()->exec_runnable();
+    auto& hdr = result.hdr;
+    binary_deserializer source{mpx(), ob};
+    auto e = source(hdr.operation, hdr.flags, hdr.sequence_number,
+                    hdr.payload_len, hdr.operation_data, result.source,
+                    result.dest, hdr.source_actor, hdr.dest_actor);
+    CAF_REQUIRE_EQUAL(e, none);
+    auto first = ob.begin() + basp::compact_header_size;
+    auto last = first + hdr.payload_len;
+    result.payload.assign(first, last);
+    ob.erase(ob.begin(), last);
+    return result;
+  }
+};
+
+class parallel_deserialization_fixture : public fixture {
+public:
+  parallel_deserialization_fixture() : fixture(false, false, true) {
+    // nop
+  }
+};
+
+class framed_reads_fixture : public fixture {
+public:
+  framed_reads_fixture() : fixture(false, false, false, true) {
+    // nop
+  }
+};
+
 } // namespace <anonymous>
 
 CAF_TEST_FIXTURE_SCOPE(basp_tests, fixture)
@@ -567,6 +636,28 @@ CAF_TEST(client_handshake_and_dispatch) {
   );
 }
 
+CAF_TEST(varint_dispatch) {
+  connect_node(jupiter());
+  // instance::write picks variable-length integer encoding for the payload
+  // based on the flags in the header
+  mock(jupiter().connection,
+       {basp::message_type::dispatch_message, basp::header::varint_flag, 0, 0,
+        jupiter().id, this_node(), jupiter().dummy_actor->id(), self()->id()},
+       std::vector<actor_addr>{},
+       make_message(1, -2, uint64_t{3}))
+  .receive(jupiter().connection,
+          basp::message_type::announce_proxy, no_flags, no_payload,
+          no_operation_data, this_node(), jupiter().id,
+          invalid_actor_id, jupiter().dummy_actor->id());
+  self()->receive(
+    [](int a, int b, uint64_t c) {
+      CAF_CHECK_EQUAL(a, 1);
+      CAF_CHECK_EQUAL(b, -2);
+      CAF_CHECK_EQUAL(c, 3u);
+    }
+  );
+}
+
 CAF_TEST(message_forwarding) {
   // connect two remote nodes
   connect_node(jupiter());
@@ -594,6 +685,59 @@ CAF_TEST(publish_and_connect) {
   connect_node(jupiter(), ax, self()->id());
 }
 
+CAF_TEST(lanes) {
+  auto ax = accept_handle::from_int(4242);
+  mpx()->provide_acceptor(4242, ax);
+  auto res = sys.middleman().publish(self(), 4242);
+  CAF_REQUIRE(res == 4242);
+  mpx()->flush_runnables(); // process publish message in basp_broker
+  connect_node(jupiter(), ax, self()->id());
+  CAF_MESSAGE("Jupiter opens an additional connection");
+  auto lane = connection_handle::from_int(42);
+  mpx()->add_pending_connect(ax, lane);
+  mpx()->accept_connection(ax);
+  mock(lane,
+       {basp::message_type::client_handshake, basp::header::lane_flag, 0, 0,
+        jupiter().id, this_node(), invalid_actor_id, invalid_actor_id},
+       std::string{})
+  .receive(lane,
+          basp::message_type::server_handshake, no_flags,
+          any_vals, basp::version, this_node(), node_id{none},
+          self()->id(), invalid_actor_id, std::string{},
+          self()->id(), std::set<std::string>{});
+  CAF_CHECK(tbl().is_lane(lane));
+  CAF_CHECK(!tbl().is_lane(jupiter().connection));
+  CAF_CHECK_EQUAL(tbl().lookup_direct(lane), jupiter().id);
+  CAF_CHECK_EQUAL(tbl().lookup(jupiter().id)->hdl, jupiter().connection);
+  CAF_CHECK_EQUAL(tbl().lookup(jupiter().id, 7)->hdl, lane);
+  CAF_MESSAGE("messages of actors travel on the lane");
+  mock(jupiter().connection,
+       {basp::message_type::dispatch_message, 0, 0, 0,
+        jupiter().id, this_node(), jupiter().dummy_actor->id(), self()->id()},
+       std::vector<actor_addr>{},
+       make_message(1, 2, 3))
+  .receive(jupiter().connection,
+          basp::message_type::announce_proxy, no_flags, no_payload,
+          no_operation_data, this_node(), jupiter().id,
+          invalid_actor_id, jupiter().dummy_actor->id());
+  self()->receive(
+    [](int a, int b, int c) {
+      return a + b + c;
+    }
+  );
+  mpx()->exec_runnable();
+  dispatch_out_buf(lane);
+  jupiter().dummy_actor->receive(
+    [](int i) {
+      CAF_CHECK_EQUAL(i, 6);
+    }
+  );
+  CAF_MESSAGE("losing the lane keeps Jupiter reachable");
+  aut()->state.cleanup(lane);
+  CAF_CHECK(tbl().lanes(jupiter().id).empty());
+  CAF_CHECK_EQUAL(tbl().lookup(jupiter().id, 7)->hdl, jupiter().connection);
+}
+
 CAF_TEST(remote_actor_and_send) {
   constexpr const char* lo = "localhost";
   CAF_MESSAGE("self: " << to_string(self()->address()));
@@ -773,6 +917,162 @@ CAF_TEST(indirect_connections) {
 
 CAF_TEST_FIXTURE_SCOPE_END()
 
+CAF_TEST_FIXTURE_SCOPE(basp_tests_with_compact_headers,
+                       compact_headers_fixture)
+
+CAF_TEST(compact_headers) {
+  auto hdl = jupiter().connection;
+  mpx()->add_pending_connect(accept_handle::from_int(1), hdl);
+  mpx()->accept_connection(accept_handle::from_int(1));
+  CAF_MESSAGE("handshakes use full headers and negotiate compact headers");
+  mock(hdl,
+       {basp::message_type::client_handshake,
+        basp::header::compact_header_flag, 0, 0,
+        jupiter().id, this_node(), invalid_actor_id, invalid_actor_id},
+       std::string{})
+  .receive(hdl,
+           basp::message_type::server_handshake,
+           basp::header::compact_header_flag, any_vals, basp::version,
+           this_node(), node_id{none}, invalid_actor_id, invalid_actor_id,
+           std::string{}, invalid_actor_id, std::set<std::string>{});
+  CAF_MESSAGE("alias 0 denotes the two endpoints of the connection");
+  auto x = compact_receive(hdl);
+  CAF_CHECK_EQUAL(x.hdr.operation, basp::message_type::dispatch_message);
+  CAF_CHECK_EQUAL(x.source, basp::endpoint_alias);
+  CAF_CHECK_EQUAL(x.dest, basp::endpoint_alias);
+  CAF_CHECK(mpx()->output_buffer(hdl).empty());
+  compact_send(hdl, basp::message_type::dispatch_message, 0,
+               basp::endpoint_alias, basp::endpoint_alias,
+               jupiter().dummy_actor->id(), self()->id(),
+               std::vector<actor_addr>{}, make_message(1, 2, 3));
+  x = compact_receive(hdl);
+  CAF_CHECK_EQUAL(x.hdr.operation, basp::message_type::announce_proxy);
+  CAF_CHECK_EQUAL(x.hdr.dest_actor, jupiter().dummy_actor->id());
+  self()->receive(
+    [](int a, int b, int c) {
+      CAF_CHECK_EQUAL(a, 1);
+      CAF_CHECK_EQUAL(b, 2);
+      CAF_CHECK_EQUAL(c, 3);
+    }
+  );
+  CAF_MESSAGE("Jupiter introduces Mars via alias 1");
+  compact_send(hdl, basp::message_type::node_alias, 1,
+               basp::endpoint_alias, basp::endpoint_alias,
+               invalid_actor_id, invalid_actor_id, mars().id);
+  compact_send(hdl, basp::message_type::dispatch_message, 0,
+               1, basp::endpoint_alias,
+               mars().dummy_actor->id(), self()->id(),
+               std::vector<actor_addr>{}, make_message("hello from mars!"));
+  CAF_MESSAGE("Earth introduces Mars via alias 1 before using it");
+  x = compact_receive(hdl);
+  CAF_CHECK_EQUAL(x.hdr.operation, basp::message_type::node_alias);
+  CAF_CHECK_EQUAL(x.hdr.operation_data, 1u);
+  node_id nid;
+  binary_deserializer bd{mpx(), x.payload};
+  CAF_CHECK_EQUAL(bd(nid), none);
+  CAF_CHECK_EQUAL(nid, mars().id);
+  x = compact_receive(hdl);
+  CAF_CHECK_EQUAL(x.hdr.operation, basp::message_type::dispatch_message);
+  CAF_CHECK_EQUAL(x.dest, 1u);
+  x = compact_receive(hdl);
+  CAF_CHECK_EQUAL(x.hdr.operation, basp::message_type::announce_proxy);
+  CAF_CHECK_EQUAL(x.source, basp::endpoint_alias);
+  CAF_CHECK_EQUAL(x.dest, 1u);
+  CAF_CHECK_EQUAL(x.hdr.dest_actor, mars().dummy_actor->id());
+  self()->receive(
+    [](const std::string& str) {
+      CAF_CHECK_EQUAL(str, "hello from mars!");
+    }
+  );
+  CAF_MESSAGE("unknown aliases close the connection");
+  compact_send(hdl, basp::message_type::dispatch_message, 0,
+               42, basp::endpoint_alias,
+               mars().dummy_actor->id(), self()->id(),
+               std::vector<actor_addr>{}, make_message(1));
+  CAF_CHECK(!tbl().lookup_direct(jupiter().id));
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST_FIXTURE_SCOPE(basp_tests_with_parallel_deserialization,
+                       parallel_deserialization_fixture)
+
+CAF_TEST(parallel_deserialization) {
+  connect_node(jupiter());
+  CAF_MESSAGE("workers deserialize messages and deliver them in order");
+  auto send_int = [&](int x) {
+    return mock(jupiter().connection,
+                {basp::message_type::dispatch_message, 0, 0, 0,
+                 jupiter().id, this_node(),
+                 jupiter().dummy_actor->id(), self()->id()},
+                std::vector<actor_addr>{}, make_message(x));
+  };
+  send_int(0)
+  .receive(jupiter().connection,
+           basp::message_type::announce_proxy, no_flags, no_payload,
+           no_operation_data, this_node(), jupiter().id,
+           invalid_actor_id, jupiter().dummy_actor->id());
+  for (int i = 1; i < 10; ++i)
+    send_int(i);
+  for (int i = 0; i < 10; ++i)
+    self()->receive(
+      [&](int x) {
+        CAF_CHECK_EQUAL(x, i);
+      }
+    );
+  CAF_MESSAGE("workers hand messages with remote actors back to the broker");
+  auto proxy = actor_cast<actor>(proxies().get(jupiter().id,
+                                               jupiter().dummy_actor->id()));
+  CAF_REQUIRE(proxy != nullptr);
+  mock(jupiter().connection,
+       {basp::message_type::dispatch_message, 0, 0, 0,
+        jupiter().id, this_node(), jupiter().dummy_actor->id(), self()->id()},
+       std::vector<actor_addr>{}, make_message(proxy));
+  auto received = false;
+  while (!received) {
+    mpx()->try_exec_runnable();
+    self()->receive(
+      [&](const actor& x) {
+        CAF_CHECK_EQUAL(x, proxy);
+        received = true;
+      },
+      after(std::chrono::milliseconds(1)) >> [] {
+        // nop
+      }
+    );
+  }
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST_FIXTURE_SCOPE(basp_tests_with_framed_reads, framed_reads_fixture)
+
+CAF_TEST(framed_reads) {
+  connect_node(jupiter());
+  auto hdl = jupiter().connection;
+  CAF_MESSAGE("BASP switches to framed reads after the handshake");
+  auto conf = mpx()->read_config(hdl);
+  CAF_REQUIRE_EQUAL(conf.first, receive_policy_flag::framed);
+  CAF_CHECK_EQUAL(receive_policy::frame_header_size(conf), basp::header_size);
+  CAF_MESSAGE("BASP handles all messages of a single read");
+  buffer buf;
+  for (int i = 0; i < 10; ++i) {
+    basp::header hdr{basp::message_type::dispatch_message, 0, 0, 0,
+                     jupiter().id, this_node(),
+                     jupiter().dummy_actor->id(), self()->id()};
+    to_buf(buf, hdr, nullptr, std::vector<actor_addr>{}, make_message(i));
+  }
+  mpx()->virtual_send(hdl, buf);
+  for (int i = 0; i < 10; ++i)
+    self()->receive(
+      [&](int x) {
+        CAF_CHECK_EQUAL(x, i);
+      }
+    );
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
 CAF_TEST_FIXTURE_SCOPE(basp_tests_with_autoconn, autoconn_enabled_fixture)
 
 CAF_TEST(automatic_connection) {
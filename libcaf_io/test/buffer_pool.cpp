@@ -0,0 +1,107 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE io_buffer_pool
+#include "caf/test/unit_test.hpp"
+
+#include "caf/io/network/buffer_pool.hpp"
+
+using namespace caf;
+using caf::io::network::buffer_pool;
+
+namespace {
+
+struct fixture {
+  buffer_pool pool;
+  buffer_pool::buffer_type buf;
+
+  fixture() : pool(64 * 1024) {
+    // nop
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(buffer_pool_tests, fixture)
+
+CAF_TEST(acquire from empty pool) {
+  pool.acquire(buf, 100);
+  CAF_CHECK(buf.empty());
+  CAF_CHECK_EQUAL(buf.capacity(), 1024u);
+  pool.acquire(buf, 5000);
+  CAF_CHECK_EQUAL(buf.capacity(), 8192u);
+  auto stats = pool.stats();
+  CAF_CHECK_EQUAL(stats.acquired, 2u);
+  CAF_CHECK_EQUAL(stats.reused, 0u);
+}
+
+CAF_TEST(release and reuse) {
+  pool.acquire(buf, 5000);
+  buf.resize(5000, 'a');
+  auto data = buf.data();
+  pool.release(buf);
+  CAF_CHECK_EQUAL(buf.capacity(), 0u);
+  auto stats = pool.stats();
+  CAF_CHECK_EQUAL(stats.released, 1u);
+  CAF_CHECK_EQUAL(stats.cached_buffers, 1u);
+  CAF_CHECK_EQUAL(stats.cached_bytes, 8192u);
+  // A request for a much smaller buffer does not take the cached buffer.
+  buffer_pool::buffer_type small;
+  pool.acquire(small, 10);
+  CAF_CHECK_NOT_EQUAL(small.data(), data);
+  // Requests for up to the capacity of the buffer take the cached buffer.
+  pool.acquire(buf, 2500);
+  CAF_CHECK(buf.empty());
+  CAF_CHECK_EQUAL(buf.data(), data);
+  stats = pool.stats();
+  CAF_CHECK_EQUAL(stats.reused, 1u);
+  CAF_CHECK_EQUAL(stats.cached_buffers, 0u);
+  CAF_CHECK_EQUAL(stats.cached_bytes, 0u);
+}
+
+CAF_TEST(capacity limit) {
+  std::vector<buffer_pool::buffer_type> bufs(5);
+  for (auto& x : bufs)
+    pool.acquire(x, 16 * 1024);
+  for (auto& x : bufs)
+    pool.release(x);
+  auto stats = pool.stats();
+  CAF_CHECK_EQUAL(stats.released, 4u);
+  CAF_CHECK_EQUAL(stats.dropped, 1u);
+  CAF_CHECK_EQUAL(stats.cached_bytes, 64u * 1024u);
+  pool.clear();
+  stats = pool.stats();
+  CAF_CHECK_EQUAL(stats.cached_buffers, 0u);
+  CAF_CHECK_EQUAL(stats.cached_bytes, 0u);
+}
+
+CAF_TEST(unpooled sizes) {
+  buf.reserve(100);
+  pool.release(buf);
+  CAF_CHECK_EQUAL(buf.capacity(), 0u);
+  pool.acquire(buf, 64 * 1024 * 1024);
+  CAF_CHECK_GREATER_OR_EQUAL(buf.capacity(), 64u * 1024u * 1024u);
+  pool.release(buf);
+  auto stats = pool.stats();
+  CAF_CHECK_EQUAL(stats.released, 0u);
+  CAF_CHECK_EQUAL(stats.dropped, 1u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
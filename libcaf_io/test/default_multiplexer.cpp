@@ -28,6 +28,13 @@
 #include "caf/io/all.hpp"
 #include "caf/io/network/default_multiplexer.hpp"
 #include "caf/io/network/operation.hpp"
+#include "caf/io/network/stream_impl.hpp"
+#include "caf/policy/tcp.hpp"
+
+#ifndef CAF_WINDOWS
+# include <sys/types.h>
+# include <sys/socket.h>
+#endif
 
 using namespace caf;
 
@@ -49,6 +56,47 @@ struct sub_fixture : test_coordinator_fixture<> {
   }
 };
 
+// Stream manager that ignores all events.
+class dummy_manager : public io::network::stream_manager {
+public:
+  bool consume(execution_unit*, const void*, size_t) override {
+    return true;
+  }
+
+  void data_transferred(execution_unit*, size_t, size_t) override {
+    // nop
+  }
+
+  uint16_t port() const override {
+    return 0;
+  }
+
+  void stop_reading() override {
+    // nop
+  }
+
+  void remove_from_loop() override {
+    // nop
+  }
+
+  void add_to_loop() override {
+    // nop
+  }
+
+  std::string addr() const override {
+    return "dummy";
+  }
+
+protected:
+  message detach_message() override {
+    return make_message();
+  }
+
+  void detach_from(io::abstract_broker*) override {
+    // nop
+  }
+};
+
 struct fixture {
   sub_fixture client;
 
@@ -102,4 +150,34 @@ CAF_TEST(scribe io_failure) {
   CAF_CHECK_EQUAL(server.mpx.num_socket_handlers(), 1u);
 }
 
+#ifndef CAF_WINDOWS
+
+CAF_TEST(stream gather writes) {
+  int fds[2];
+  CAF_REQUIRE_EQUAL(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  io::network::stream_impl<policy::tcp> x{client.mpx, fds[0]};
+  auto mgr = make_counted<dummy_manager>();
+  CAF_MESSAGE("flushing moves data out of the offline buffer");
+  std::string hello = "hello ";
+  x.write(hello.data(), hello.size());
+  x.flush(mgr);
+  CAF_CHECK(x.wr_buf().empty());
+  CAF_MESSAGE("data written during a pending write remains in the offline "
+              "buffer");
+  std::string world = "world";
+  x.write(world.data(), world.size());
+  x.flush(mgr);
+  CAF_CHECK_EQUAL(x.wr_buf().size(), world.size());
+  CAF_MESSAGE("a single write event sends both buffers");
+  x.handle_event(io::network::operation::write);
+  CAF_CHECK(x.wr_buf().empty());
+  char buf[32];
+  auto res = ::recv(fds[1], buf, sizeof(buf), 0);
+  CAF_REQUIRE(res > 0);
+  CAF_CHECK_EQUAL(std::string(buf, static_cast<size_t>(res)), "hello world");
+  io::network::close_socket(fds[1]);
+}
+
+#endif // CAF_WINDOWS
+
 CAF_TEST_FIXTURE_SCOPE_END()
@@ -22,6 +22,7 @@
 #include "caf/test/dsl.hpp"
 
 #include <memory>
+#include <algorithm>
 #include <iostream>
 
 #include "caf/all.hpp"
@@ -29,6 +30,8 @@
 
 #include "caf/string_algorithms.hpp"
 
+#include "caf/io/network/uring_multiplexer.hpp"
+
 using namespace std;
 using namespace caf;
 using namespace caf::io;
@@ -181,6 +184,72 @@ void run_server(int argc, char** argv) {
   child.join();
 }
 
+// Runs the ping-pong setup with server and client in the same actor system.
+void run_local(actor_system& system) {
+  auto& mm = system.middleman();
+  scoped_actor self{system};
+  auto serv = mm.spawn_broker(peer_acceptor_fun, system.spawn(pong));
+  self->request(serv, infinite, publish_atom::value).receive(
+    [&](uint16_t port) {
+      CAF_MESSAGE("server is running on port " << port);
+      auto p = system.spawn(ping, size_t{10});
+      auto cl = unbox(mm.spawn_client(peer_fun, "127.0.0.1", port, p));
+      anon_send(p, kickoff_atom::value, cl);
+    },
+    [&](const error& err) {
+      CAF_FAIL("Error: " << system.render(err));
+    }
+  );
+  self->await_all_other_actors_done();
+}
+
+// Frames for `framed_reads`: a 4-byte length in network byte order followed by
+// the payload, which repeats the index of the frame.
+std::vector<char> make_frame(uint32_t index, uint32_t len) {
+  std::vector<char> result{static_cast<char>(len >> 24),
+                           static_cast<char>(len >> 16),
+                           static_cast<char>(len >> 8),
+                           static_cast<char>(len)};
+  result.resize(result.size() + len, static_cast<char>(index));
+  return result;
+}
+
+behavior frame_reader_fun(broker* self, const actor& buddy, size_t num_frames) {
+  auto batches = std::make_shared<size_t>(0);
+  auto frames = std::make_shared<size_t>(0);
+  return {
+    [=](const new_connection_msg& msg) {
+      self->configure_read(msg.handle, receive_policy::framed(4, 0));
+    },
+    [=](const new_data_msg& msg) {
+      ++*batches;
+      auto cfg = receive_policy::framed(4, 0);
+      size_t pos = 0;
+      while (pos < msg.buf.size()) {
+        auto fsize = receive_policy::frame_size(cfg, msg.buf.data() + pos);
+        CAF_REQUIRE(pos + fsize <= msg.buf.size());
+        auto tag = static_cast<char>(*frames);
+        auto first = msg.buf.begin() + static_cast<ptrdiff_t>(pos + 4);
+        auto last = msg.buf.begin() + static_cast<ptrdiff_t>(pos + fsize);
+        CAF_CHECK(std::all_of(first, last,
+                              [=](char x) { return x == tag; }));
+        pos += fsize;
+        ++*frames;
+      }
+      if (*frames == num_frames) {
+        self->send(buddy, *frames, *batches);
+        self->quit();
+      }
+    },
+    [=](publish_atom) -> expected<uint16_t> {
+      auto res = self->add_tcp_doorman(0, "127.0.0.1");
+      if (!res)
+        return std::move(res.error());
+      return res->second;
+    }
+  };
+}
+
 } // namespace <anonymous>
 
 CAF_TEST(test_broker) {
@@ -188,3 +257,89 @@ CAF_TEST(test_broker) {
   auto argv = test::engine::argv();
   run_server(argc, argv);
 }
+
+CAF_TEST(sharded_multiplexers) {
+  actor_system_config cfg;
+  cfg.load<io::middleman>().set("middleman.multiplexer-threads", 2);
+  actor_system system{cfg};
+  auto& mm = system.middleman();
+  CAF_CHECK_EQUAL(mm.backend_count(), 2u);
+  CAF_CHECK_NOT_EQUAL(&mm.next_backend(), &mm.next_backend());
+  run_local(system);
+}
+
+CAF_TEST(buffer_pool) {
+  actor_system_config cfg;
+  cfg.load<io::middleman>()
+    .set("middleman.multiplexer-threads", 2)
+    .set("middleman.buffer-pool-size", 1024 * 1024);
+  actor_system system{cfg};
+  auto& mm = system.middleman();
+  CAF_CHECK_EQUAL(mm.backend().buffers(), &mm.buffers());
+  CAF_CHECK_EQUAL(mm.next_backend().buffers(), &mm.buffers());
+  run_local(system);
+  // Idle connections return their buffers and reuse them for the next read.
+  auto stats = mm.buffers().stats();
+  CAF_MESSAGE("buffer pool statistics: " << deep_to_string(stats));
+  CAF_CHECK_GREATER(stats.released, 0u);
+  CAF_CHECK_GREATER(stats.reused, 0u);
+  CAF_CHECK_LESS_OR_EQUAL(stats.cached_bytes, 1024u * 1024u);
+}
+
+#ifdef CAF_URING_MULTIPLEXER
+
+CAF_TEST(uring_backend) {
+  if (!network::uring_multiplexer::available()) {
+    CAF_MESSAGE("io_uring unavailable, skip test");
+    return;
+  }
+  actor_system_config cfg;
+  cfg.load<io::middleman>().set("middleman.network-backend", atom("uring"));
+  actor_system system{cfg};
+  auto& mpx = system.middleman().backend();
+  CAF_CHECK(dynamic_cast<network::uring_multiplexer*>(&mpx) != nullptr);
+  run_local(system);
+}
+
+#endif // CAF_URING_MULTIPLEXER
+
+CAF_TEST(framed_reads) {
+  // Many small frames plus one frame exceeding the default read-ahead size.
+  const size_t num_frames = 101;
+  actor_system_config cfg;
+  actor_system system{cfg.load<io::middleman>()};
+  auto& mm = system.middleman();
+  scoped_actor self{system};
+  auto serv = mm.spawn_broker(frame_reader_fun, self, num_frames);
+  actor client;
+  self->request(serv, infinite, publish_atom::value).receive(
+    [&](uint16_t port) {
+      auto writer = [=](broker* bself, connection_handle hdl) -> behavior {
+        auto& buf = bself->wr_buf(hdl);
+        for (uint32_t i = 0; i < num_frames; ++i) {
+          auto frame = make_frame(i, i == num_frames / 2 ? 100000 : i % 7);
+          buf.insert(buf.end(), frame.begin(), frame.end());
+        }
+        bself->flush(hdl);
+        return {
+          [=](const connection_closed_msg&) {
+            bself->quit();
+          }
+        };
+      };
+      client = unbox(mm.spawn_client(writer, "127.0.0.1", port));
+    },
+    [&](const error& err) {
+      CAF_FAIL("Error: " << system.render(err));
+    }
+  );
+  self->receive(
+    [&](size_t frames, size_t batches) {
+      CAF_CHECK_EQUAL(frames, num_frames);
+      CAF_MESSAGE("received " << frames << " frames in " << batches
+                  << " batches");
+      CAF_CHECK_LESS(batches, frames);
+    }
+  );
+  anon_send_exit(client, exit_reason::user_shutdown);
+}
@@ -0,0 +1,132 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE io_basp_fragment_scheduler
+#include "caf/test/unit_test.hpp"
+
+#include <string>
+#include <vector>
+
+#include "caf/io/basp/fragment_scheduler.hpp"
+
+using namespace caf;
+using namespace caf::io::basp;
+
+namespace {
+
+// Records each frame as "<flow>:<size>", using the first byte of the data as
+// flow name and marking whole messages with an asterisk.
+struct fixture {
+  fragment_scheduler sched;
+  std::vector<std::string> frames;
+
+  fixture() : sched(10) {
+    // nop
+  }
+
+  static buffer_type make_data(char name, size_t size) {
+    return buffer_type(size, name);
+  }
+
+  void round() {
+    frames.clear();
+    sched.round([&](header* hdr, const char* data, size_t size) {
+      std::string str{data[0]};
+      if (hdr == nullptr) {
+        str += '*';
+      } else {
+        CAF_CHECK_EQUAL(hdr->operation, message_type::fragment);
+        CAF_CHECK_EQUAL(hdr->payload_len, size);
+      }
+      str += ':';
+      str += std::to_string(size);
+      frames.emplace_back(std::move(str));
+    });
+  }
+
+  header fragment_hdr() {
+    return {message_type::fragment, 0, 0, 0, none, none, 0, 0};
+  }
+};
+
+using frame_list = std::vector<std::string>;
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(fragment_scheduler_tests, fixture)
+
+CAF_TEST(splitting) {
+  CAF_CHECK(sched.empty());
+  sched.push(1, 1, make_data('a', 25), fragment_hdr());
+  CAF_CHECK(sched.pending(1));
+  CAF_CHECK(!sched.pending(2));
+  CAF_CHECK_EQUAL(sched.buffered(), 25u);
+  round();
+  CAF_CHECK_EQUAL(frames, frame_list({"a:10"}));
+  round();
+  CAF_CHECK_EQUAL(frames, frame_list({"a:10"}));
+  round();
+  CAF_CHECK_EQUAL(frames, frame_list({"a:5"}));
+  CAF_CHECK(sched.empty());
+  CAF_CHECK_EQUAL(sched.buffered(), 0u);
+}
+
+CAF_TEST(interleaving) {
+  sched.push(1, 1, make_data('a', 20), fragment_hdr());
+  sched.push(2, 1, make_data('b', 20), fragment_hdr());
+  round();
+  CAF_CHECK_EQUAL(frames, frame_list({"a:10", "b:10"}));
+  round();
+  CAF_CHECK_EQUAL(frames, frame_list({"a:10", "b:10"}));
+  CAF_CHECK(sched.empty());
+}
+
+CAF_TEST(weights) {
+  sched.push(1, 1, make_data('a', 40), fragment_hdr());
+  sched.push(2, 3, make_data('b', 40), fragment_hdr());
+  round();
+  CAF_CHECK_EQUAL(frames, frame_list({"a:10", "b:10", "b:10", "b:10"}));
+  round();
+  CAF_CHECK_EQUAL(frames, frame_list({"a:10", "b:10"}));
+  round();
+  CAF_CHECK_EQUAL(frames, frame_list({"a:10"}));
+}
+
+CAF_TEST(ordering within flows) {
+  sched.push(1, 1, make_data('a', 15), fragment_hdr());
+  sched.push(1, 1, make_data('c', 4));
+  sched.push(2, 1, make_data('b', 4));
+  round();
+  CAF_CHECK_EQUAL(frames, frame_list({"a:10", "b*:4"}));
+  round();
+  CAF_CHECK_EQUAL(frames, frame_list({"a:5", "c*:4"}));
+  CAF_CHECK(sched.empty());
+}
+
+CAF_TEST(deficit carries over) {
+  sched.push(1, 1, make_data('a', 15));
+  round();
+  CAF_CHECK(frames.empty());
+  round();
+  CAF_CHECK_EQUAL(frames, frame_list({"a*:15"}));
+  CAF_CHECK(sched.empty());
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,148 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE io_basp_lz_codec
+#include "caf/test/unit_test.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "caf/io/basp/lz_codec.hpp"
+
+using namespace caf;
+using namespace caf::io::basp;
+
+namespace {
+
+struct fixture {
+  lz_codec codec;
+
+  // Compresses and decompresses `xs`, returning the compressed size.
+  size_t round_trip(const buffer_type& xs) {
+    buffer_type compressed;
+    codec.compress(xs.data(), xs.size(), compressed);
+    buffer_type ys;
+    CAF_REQUIRE(codec.decompress(compressed.data(), compressed.size(),
+                                 xs.size(), ys));
+    CAF_CHECK(xs == ys);
+    return compressed.size();
+  }
+};
+
+buffer_type make_buf(const std::string& str) {
+  return {str.begin(), str.end()};
+}
+
+buffer_type make_random(size_t size) {
+  std::minstd_rand rng{42};
+  buffer_type result(size);
+  for (auto& x : result)
+    x = static_cast<char>(rng() & 0xFF);
+  return result;
+}
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(lz_codec_tests, fixture)
+
+CAF_TEST(name) {
+  CAF_CHECK_EQUAL(codec.name(), atom("lz"));
+}
+
+CAF_TEST(empty and short inputs) {
+  round_trip({});
+  round_trip(make_buf("a"));
+  round_trip(make_buf("abc"));
+  round_trip(make_buf("hello world"));
+}
+
+CAF_TEST(repetitive inputs) {
+  std::string str;
+  for (int i = 0; i < 1000; ++i)
+    str += "caf::io::basp::message_type ";
+  auto xs = make_buf(str);
+  CAF_CHECK_LESS(round_trip(xs), xs.size() / 10);
+}
+
+CAF_TEST(overlapping matches) {
+  // A single character repeats itself with an offset of 1.
+  buffer_type xs(100000, 'x');
+  CAF_CHECK_LESS(round_trip(xs), 1000u);
+  // Alternating pattern with an offset of 2.
+  for (size_t i = 0; i < xs.size(); ++i)
+    xs[i] = i % 2 == 0 ? 'a' : 'b';
+  round_trip(xs);
+}
+
+CAF_TEST(incompressible inputs) {
+  auto xs = make_random(100000);
+  CAF_CHECK_LESS(round_trip(xs), xs.size() + xs.size() / 100);
+}
+
+CAF_TEST(long literals followed by long matches) {
+  auto xs = make_random(1000);
+  xs.insert(xs.end(), 1000, 'y');
+  auto ys = make_random(300);
+  xs.insert(xs.end(), ys.begin(), ys.end());
+  round_trip(xs);
+}
+
+CAF_TEST(appending output) {
+  auto xs = make_buf("abcabcabcabcabcabc");
+  buffer_type compressed{'?'};
+  codec.compress(xs.data(), xs.size(), compressed);
+  buffer_type ys{'!'};
+  CAF_REQUIRE(codec.decompress(compressed.data() + 1, compressed.size() - 1,
+                               xs.size(), ys));
+  CAF_CHECK_EQUAL(ys.front(), '!');
+  CAF_CHECK(buffer_type(ys.begin() + 1, ys.end()) == xs);
+}
+
+CAF_TEST(malformed inputs) {
+  std::string str;
+  for (int i = 0; i < 100; ++i)
+    str += "abcdefgh";
+  auto xs = make_buf(str);
+  buffer_type compressed;
+  codec.compress(xs.data(), xs.size(), compressed);
+  buffer_type ys;
+  CAF_MESSAGE("wrong size");
+  CAF_CHECK(!codec.decompress(compressed.data(), compressed.size(),
+                              xs.size() + 1, ys));
+  ys.clear();
+  CAF_CHECK(!codec.decompress(compressed.data(), compressed.size(),
+                              xs.size() - 1, ys));
+  CAF_MESSAGE("truncated input");
+  for (size_t len = 0; len < compressed.size(); ++len) {
+    ys.clear();
+    CAF_CHECK(!codec.decompress(compressed.data(), len, xs.size(), ys));
+  }
+  CAF_MESSAGE("offset pointing before the first byte");
+  buffer_type bad{static_cast<char>(0x10), 'a', 2, 0};
+  ys.clear();
+  CAF_CHECK(!codec.decompress(bad.data(), bad.size(), 5, ys));
+  CAF_MESSAGE("zero offset");
+  bad[2] = 0;
+  ys.clear();
+  CAF_CHECK(!codec.decompress(bad.data(), bad.size(), 5, ys));
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -21,6 +21,9 @@
 #define CAF_SUITE io_dynamic_remote_actor_tcp
 #include "caf/test/dsl.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <vector>
 #include <sstream>
 #include <utility>
@@ -28,6 +31,7 @@
 
 #include "caf/all.hpp"
 #include "caf/io/all.hpp"
+#include "caf/io/basp/lz_codec.hpp"
 
 using namespace caf;
 
@@ -138,8 +142,67 @@ behavior linking_actor(event_based_actor* self, const actor& buddy) {
   };
 }
 
+behavior counting_sink(stateful_actor<int>* self) {
+  return {
+    [=](const std::vector<int>&) {
+      ++self->state;
+    },
+    [=](get_atom) {
+      return self->state;
+    }
+  };
+}
+
+// Sends `n` vectors to `sink`, one per message to itself.
+behavior bulk_sender(event_based_actor* self, const actor& sink, int n,
+                     const actor& listener) {
+  std::vector<int> xs(10000, 1);
+  self->send(self, 0);
+  return {
+    [=](int i) {
+      if (i < n) {
+        self->send(sink, xs);
+        self->send(self, i + 1);
+        return;
+      }
+      self->request(sink, infinite, get_atom::value).then(
+        [=](int count) {
+          self->send(listener, count);
+          self->quit();
+        }
+      );
+    }
+  };
+}
+
 } // namespace <anonymous>
 
+// Counts how often the BASP brokers of both nodes used the codec.
+class counting_codec : public io::basp::lz_codec {
+public:
+  atom_value name() const override {
+    return atom("counting");
+  }
+
+  void compress(const char* data, size_t size,
+                io::basp::buffer_type& out) override {
+    ++compressed;
+    lz_codec::compress(data, size, out);
+  }
+
+  bool decompress(const char* data, size_t len, size_t size,
+                  io::basp::buffer_type& out) override {
+    ++decompressed;
+    return lz_codec::decompress(data, len, size, out);
+  }
+
+  static std::atomic<size_t> compressed;
+  static std::atomic<size_t> decompressed;
+};
+
+std::atomic<size_t> counting_codec::compressed;
+std::atomic<size_t> counting_codec::decompressed;
+
 CAF_TEST_FIXTURE_SCOPE(dynamic_remote_actor_tests, fixture)
 
 CAF_TEST(identity_semantics_tcp) {
@@ -191,3 +254,161 @@ CAF_TEST(remote_link_tcp) {
 }
 
 CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST(multiple_connections_per_peer) {
+  config server_cfg;
+  config client_cfg;
+  client_cfg.set("middleman.connections-per-peer", 3);
+  actor_system server_side{server_cfg};
+  actor_system client_side{client_cfg};
+  // server side
+  auto port1 = unbox(server_side.middleman().publish(
+    server_side.spawn(make_pong_behavior), 0, local_host));
+  auto port2 = unbox(server_side.middleman().publish(
+    server_side.spawn(make_sort_behavior), 0, local_host));
+  auto port3 = unbox(server_side.middleman().publish(
+    server_side.spawn(fragile_mirror), 0, local_host));
+  // client side
+  auto pong = unbox(client_side.middleman().remote_actor(local_host, port1));
+  auto sorter = unbox(client_side.middleman().remote_actor(local_host, port2));
+  auto mirror = unbox(client_side.middleman().remote_actor(local_host, port3));
+  client_side.spawn(make_ping_behavior, pong);
+  client_side.spawn(make_sort_requester_behavior, sorter);
+  auto linker = client_side.spawn(linking_actor, mirror);
+  scoped_actor self{client_side};
+  self->wait_for(linker);
+  self->wait_for(mirror);
+}
+
+CAF_TEST(fragmented_messages) {
+  config server_cfg;
+  server_cfg.set("middleman.fragment-size", 1024);
+  config client_cfg;
+  client_cfg.set("middleman.fragment-size", 1024);
+  actor_system server_side{server_cfg};
+  actor_system client_side{client_cfg};
+  // server side
+  auto port1 = unbox(server_side.middleman().publish(
+    server_side.spawn(make_pong_behavior), 0, local_host));
+  auto port2 = unbox(server_side.middleman().publish(
+    server_side.spawn(make_sort_behavior), 0, local_host));
+  // client side
+  auto pong = unbox(client_side.middleman().remote_actor(local_host, port1));
+  auto sorter = unbox(client_side.middleman().remote_actor(local_host, port2));
+  client_side.spawn(make_ping_behavior, pong);
+  std::vector<int> xs(100000);
+  for (size_t i = 0; i < xs.size(); ++i)
+    xs[i] = static_cast<int>(xs.size() - i);
+  scoped_actor self{client_side};
+  for (int i = 0; i < 3; ++i)
+    self->send(sorter, xs);
+  for (int i = 0; i < 3; ++i)
+    self->receive(
+      [&](const std::vector<int>& ys) {
+        CAF_CHECK(std::is_sorted(ys.begin(), ys.end()));
+        CAF_CHECK_EQUAL(ys.size(), xs.size());
+      }
+    );
+  anon_send_exit(sorter, exit_reason::user_shutdown);
+}
+
+CAF_TEST(backpressure) {
+  config server_cfg;
+  config client_cfg;
+  client_cfg.set("middleman.high-watermark", 4096);
+  client_cfg.set("middleman.backpressure", atom("pause"));
+  actor_system server_side{server_cfg};
+  actor_system client_side{client_cfg};
+  // server side
+  auto port = unbox(server_side.middleman().publish(
+    server_side.spawn(counting_sink), 0, local_host));
+  // client side
+  auto sink = unbox(client_side.middleman().remote_actor(local_host, port));
+  scoped_actor self{client_side};
+  client_side.spawn(bulk_sender, sink, 100, actor{self});
+  self->receive(
+    [&](int count) {
+      // Pausing senders never drops any message.
+      CAF_CHECK_EQUAL(count, 100);
+    }
+  );
+  // The connection eventually transmits all buffered bytes, but the sender
+  // may trigger a last message to the server when terminating.
+  auto buffered = [&] {
+    return client_side.middleman().buffered_bytes(sink->node());
+  };
+  for (int i = 0; i < 100 && buffered() > 0; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  CAF_CHECK_EQUAL(buffered(), 0u);
+  anon_send_exit(sink, exit_reason::user_shutdown);
+}
+
+CAF_TEST(compressed_messages) {
+  config server_cfg;
+  server_cfg.add_codec_type<counting_codec>();
+  server_cfg.set("middleman.compression", atom("counting"));
+  config client_cfg;
+  client_cfg.add_codec_type<counting_codec>();
+  client_cfg.set("middleman.compression", atom("counting"));
+  client_cfg.set("middleman.enable-compact-headers", true);
+  client_cfg.set("middleman.enable-framed-reads", true);
+  server_cfg.set("middleman.enable-compact-headers", true);
+  actor_system server_side{server_cfg};
+  actor_system client_side{client_cfg};
+  // server side
+  auto port1 = unbox(server_side.middleman().publish(
+    server_side.spawn(make_pong_behavior), 0, local_host));
+  auto port2 = unbox(server_side.middleman().publish(
+    server_side.spawn(make_sort_behavior), 0, local_host));
+  // client side
+  auto pong = unbox(client_side.middleman().remote_actor(local_host, port1));
+  auto sorter = unbox(client_side.middleman().remote_actor(local_host, port2));
+  client_side.spawn(make_ping_behavior, pong);
+  std::vector<int> xs(10000);
+  for (size_t i = 0; i < xs.size(); ++i)
+    xs[i] = static_cast<int>(i % 10);
+  scoped_actor self{client_side};
+  for (int i = 0; i < 3; ++i)
+    self->send(sorter, xs);
+  for (int i = 0; i < 3; ++i)
+    self->receive(
+      [&](const std::vector<int>& ys) {
+        CAF_CHECK(std::is_sorted(ys.begin(), ys.end()));
+        CAF_CHECK_EQUAL(ys.size(), xs.size());
+      }
+    );
+  // Both nodes compress their large messages and decompress the replies.
+  CAF_CHECK_GREATER_OR_EQUAL(counting_codec::compressed.load(), 6u);
+  CAF_CHECK_GREATER_OR_EQUAL(counting_codec::decompressed.load(), 6u);
+  anon_send_exit(sorter, exit_reason::user_shutdown);
+}
+
+#ifndef CAF_WINDOWS
+
+CAF_TEST(ping_pong_unix_socket) {
+  config server_cfg;
+  server_cfg.set("middleman.unix-socket-dir", "/tmp");
+  config client_cfg;
+  client_cfg.set("middleman.unix-socket-dir", "/tmp");
+  actor_system server_side{server_cfg};
+  actor_system client_side{client_cfg};
+  // server side
+  auto port = unbox(server_side.middleman().publish(
+    server_side.spawn(make_pong_behavior), 0, local_host));
+  // client side
+  auto pong = unbox(client_side.middleman().remote_actor(local_host, port));
+  scoped_actor self{client_side};
+  self->request(client_side.middleman().actor_handle(), infinite,
+                get_atom::value, pong->node()).receive(
+    [&](const node_id&, const std::string& addr, uint16_t remote_port) {
+      CAF_CHECK_EQUAL(addr, "/tmp/caf-" + std::to_string(port) + ".sock");
+      CAF_CHECK_EQUAL(remote_port, port);
+    },
+    [&](const error& err) {
+      CAF_FAIL("unexpected error: " << client_side.render(err));
+    }
+  );
+  client_side.spawn(make_ping_behavior, pong);
+}
+
+#endif // CAF_WINDOWS
@@ -248,4 +248,58 @@ CAF_TEST(multiple_endpoints_udp) {
   anon_send_exit(mirror, exit_reason::user_shutdown);
 }
 
+CAF_TEST(batched_datagrams_udp) {
+  config server_cfg;
+  server_cfg.set("middleman.datagram-batch-size", 16);
+  actor_system server_sys{server_cfg};
+  config client_cfg;
+  client_cfg.set("middleman.datagram-batch-size", 16);
+  actor_system client_sys{client_cfg};
+  auto port = unbox(server_sys.middleman().publish_udp(
+    server_sys.spawn(make_pong_behavior), 0, local_host));
+  auto pong = unbox(client_sys.middleman().remote_actor_udp(local_host, port));
+  CAF_MESSAGE("send a burst of messages that fills several batches");
+  scoped_actor self{client_sys};
+  for (int i = 0; i < 100; ++i)
+    self->send(pong, i);
+  int sum = 0;
+  for (int i = 0; i < 100; ++i)
+    self->receive(
+      [&](int x) {
+        sum += x;
+      }
+    );
+  CAF_CHECK_EQUAL(sum, 5050);
+  anon_send_exit(pong, exit_reason::user_shutdown);
+}
+
+CAF_TEST(reliable_udp) {
+  config server_cfg;
+  server_cfg.set("middleman.enable-reliable-udp", true);
+  server_cfg.set("middleman.reliable-udp-window", 16);
+  actor_system server_sys{server_cfg};
+  config client_cfg;
+  client_cfg.set("middleman.enable-reliable-udp", true);
+  client_cfg.set("middleman.reliable-udp-window", 16);
+  actor_system client_sys{client_cfg};
+  auto port = unbox(server_sys.middleman().publish_udp(
+    server_sys.spawn(make_pong_behavior), 0, local_host));
+  auto pong = unbox(client_sys.middleman().remote_actor_udp(local_host, port));
+  CAF_MESSAGE("send more messages than the window admits at once");
+  scoped_actor self{client_sys};
+  for (int i = 0; i < 500; ++i)
+    self->send(pong, i);
+  std::vector<int> received;
+  for (int i = 0; i < 500; ++i)
+    self->receive(
+      [&](int x) {
+        received.push_back(x);
+      }
+    );
+  CAF_REQUIRE_EQUAL(received.size(), 500u);
+  for (int i = 0; i < 500; ++i)
+    CAF_CHECK_EQUAL(received[static_cast<size_t>(i)], i + 1);
+  anon_send_exit(pong, exit_reason::user_shutdown);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
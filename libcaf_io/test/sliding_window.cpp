@@ -0,0 +1,291 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2016                                                  *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE io_basp_sliding_window
+#include "caf/test/unit_test.hpp"
+
+#include <map>
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+#include "caf/io/basp/sliding_window.hpp"
+
+using namespace caf;
+using namespace caf::io::basp;
+
+using std::chrono::milliseconds;
+
+namespace {
+
+using time_point = sliding_window::time_point;
+
+// Returns a datagram that carries `seq` in its first two bytes.
+buffer_type make_datagram(sequence_type seq) {
+  return {static_cast<char>(seq >> 8), static_cast<char>(seq & 0xFF)};
+}
+
+sequence_type seq_of(const buffer_type& buf) {
+  return static_cast<sequence_type>(
+    (static_cast<uint8_t>(buf[0]) << 8) | static_cast<uint8_t>(buf[1]));
+}
+
+struct fixture {
+  sliding_window win;
+  std::vector<sequence_type> sent;
+  time_point now;
+
+  fixture() : win(16), now(sliding_window::clock_type::now()) {
+    // nop
+  }
+
+  void push(sequence_type first, sequence_type last) {
+    for (auto seq = first; seq != last; ++seq)
+      win.push(seq, make_datagram(seq), now, recorder());
+  }
+
+  void ack(sequence_type next, uint64_t sack = 0) {
+    win.ack(next, sack, now, recorder());
+  }
+
+  void timeout() {
+    win.timeout(now, recorder());
+  }
+
+  std::function<void (const buffer_type&)> recorder() {
+    return [=](const buffer_type& buf) { sent.push_back(seq_of(buf)); };
+  }
+
+  std::vector<sequence_type> take_sent() {
+    std::vector<sequence_type> result;
+    result.swap(sent);
+    return result;
+  }
+};
+
+using seq_list = std::vector<sequence_type>;
+
+// Delivers datagrams with a fixed delay, dropping and reordering some of them
+// based on a deterministic pseudo-random sequence.
+struct lossy_link {
+  struct in_transit {
+    time_point arrival;
+    buffer_type buf;
+  };
+
+  lossy_link(unsigned loss_percent, milliseconds delay)
+      : loss(loss_percent),
+        latency(delay),
+        state(42) {
+    // nop
+  }
+
+  unsigned next() {
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) % 100;
+  }
+
+  void send(const buffer_type& buf, time_point now) {
+    if (next() < loss)
+      return;
+    // Delay every tenth datagram a bit longer to reorder it.
+    auto delay = next() < 10 ? latency * 2 : latency;
+    queue.push_back(in_transit{now + delay, buf});
+  }
+
+  template <class F>
+  void deliver(time_point now, F f) {
+    std::deque<in_transit> later;
+    for (auto& x : queue) {
+      if (x.arrival <= now)
+        f(x.buf);
+      else
+        later.push_back(std::move(x));
+    }
+    queue.swap(later);
+  }
+
+  unsigned loss;
+  milliseconds latency;
+  uint32_t state;
+  std::deque<in_transit> queue;
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(sliding_window_tests, fixture)
+
+CAF_TEST(slow start) {
+  CAF_CHECK(win.empty());
+  push(0, 10);
+  CAF_CHECK_EQUAL(take_sent(), seq_list({0, 1, 2, 3}));
+  CAF_CHECK_EQUAL(win.in_flight(), 4u);
+  CAF_CHECK_EQUAL(win.backlog(), 6u);
+  now += milliseconds(20);
+  ack(4);
+  CAF_CHECK_EQUAL(win.cwnd(), 8u);
+  CAF_CHECK_EQUAL(take_sent(), seq_list({4, 5, 6, 7, 8, 9}));
+  CAF_CHECK_EQUAL(win.backlog(), 0u);
+  ack(10);
+  CAF_CHECK(win.empty());
+  CAF_CHECK_EQUAL(win.retransmissions(), 0u);
+  CAF_CHECK(!win.deadline());
+}
+
+CAF_TEST(window size limits datagrams in flight) {
+  push(0, 4);
+  ack(4);
+  ack(4);
+  push(4, 40);
+  CAF_CHECK_EQUAL(win.in_flight(), 8u);
+  ack(12);
+  CAF_CHECK_EQUAL(win.cwnd(), 16u);
+  CAF_CHECK_EQUAL(win.in_flight(), 16u);
+  ack(28);
+  CAF_CHECK_EQUAL(win.cwnd(), 16u);
+  CAF_CHECK_EQUAL(win.in_flight(), 12u);
+  CAF_CHECK_EQUAL(win.backlog(), 0u);
+}
+
+CAF_TEST(round trip time estimation) {
+  push(0, 1);
+  CAF_CHECK(win.rto() == milliseconds(200));
+  CAF_REQUIRE(win.deadline());
+  CAF_CHECK(*win.deadline() == now + milliseconds(200));
+  now += milliseconds(50);
+  ack(1);
+  CAF_CHECK(win.srtt() == milliseconds(50));
+  // RTO = SRTT + 4 * RTTVAR with RTTVAR = SRTT / 2 for the first sample.
+  CAF_CHECK(win.rto() == milliseconds(150));
+}
+
+CAF_TEST(selective acknowledgements trigger fast retransmit) {
+  push(0, 4);
+  ack(4);
+  take_sent();
+  push(4, 12);
+  CAF_CHECK_EQUAL(take_sent(), seq_list({4, 5, 6, 7, 8, 9, 10, 11}));
+  // Datagram 4 went missing, the receiver got 5 and 6.
+  ack(4, 0x03);
+  CAF_CHECK_EQUAL(take_sent(), seq_list{});
+  CAF_CHECK_EQUAL(win.cwnd(), 10u);
+  // The third acknowledged successor triggers the retransmission.
+  ack(4, 0x07);
+  CAF_CHECK_EQUAL(take_sent(), seq_list({4}));
+  CAF_CHECK_EQUAL(win.retransmissions(), 1u);
+  CAF_CHECK_EQUAL(win.cwnd(), 5u);
+  // Further SACKs do not retransmit the same datagram again.
+  ack(4, 0x0F);
+  CAF_CHECK_EQUAL(take_sent(), seq_list{});
+  CAF_CHECK_EQUAL(win.retransmissions(), 1u);
+  ack(12);
+  CAF_CHECK(win.empty());
+}
+
+CAF_TEST(timeouts retransmit all unacknowledged datagrams) {
+  push(0, 3);
+  take_sent();
+  now += milliseconds(100);
+  timeout();
+  CAF_CHECK_EQUAL(take_sent(), seq_list{});
+  now += milliseconds(100);
+  timeout();
+  CAF_CHECK_EQUAL(take_sent(), seq_list({0, 1, 2}));
+  CAF_CHECK_EQUAL(win.retransmissions(), 3u);
+  CAF_CHECK_EQUAL(win.cwnd(), 1u);
+  CAF_CHECK(win.rto() == milliseconds(400));
+  // Karn's algorithm: no RTT sample from retransmitted datagrams.
+  now += milliseconds(10);
+  ack(3);
+  CAF_CHECK(win.rto() == milliseconds(400));
+  CAF_CHECK(win.empty());
+}
+
+CAF_TEST(sequence numbers wrap around) {
+  push(65534, 2);
+  CAF_CHECK_EQUAL(take_sent(), seq_list({65534, 65535, 0, 1}));
+  ack(0);
+  CAF_CHECK_EQUAL(win.in_flight(), 2u);
+  ack(1);
+  CAF_CHECK_EQUAL(win.in_flight(), 1u);
+  ack(2);
+  CAF_CHECK(win.empty());
+}
+
+CAF_TEST(lossy link) {
+  lossy_link data_link{10, milliseconds(5)};
+  lossy_link ack_link{10, milliseconds(5)};
+  // Receiver state, mirroring BASP endpoints with ordering.
+  sequence_type next = 0;
+  std::map<sequence_type, buffer_type> pending;
+  std::vector<sequence_type> delivered;
+  auto is_after = [](sequence_type x, sequence_type y) {
+    return static_cast<int16_t>(static_cast<sequence_type>(x - y)) > 0;
+  };
+  auto send = [&](const buffer_type& buf) { data_link.send(buf, now); };
+  const sequence_type total = 1000;
+  sequence_type pushed = 0;
+  // Run until the sender received the acknowledgements for all datagrams.
+  for (int step = 0; step < 100000 && (pushed < total || !win.empty());
+       ++step) {
+    now += milliseconds(1);
+    while (pushed < total && win.backlog() < 8) {
+      win.push(pushed, make_datagram(pushed), now, send);
+      ++pushed;
+    }
+    data_link.deliver(now, [&](const buffer_type& buf) {
+      auto seq = seq_of(buf);
+      if (seq == next) {
+        delivered.push_back(next++);
+        for (auto i = pending.begin();
+             i != pending.end() && i->first == next;
+             i = pending.erase(i))
+          delivered.push_back(next++);
+      } else if (is_after(seq, next)) {
+        pending.emplace(seq, buf);
+      }
+      uint64_t sack = 0;
+      for (auto& kvp : pending)
+        sack |= uint64_t{1} << static_cast<sequence_type>(kvp.first - next - 1);
+      buffer_type ack_buf = make_datagram(next);
+      for (int i = 0; i < 8; ++i)
+        ack_buf.push_back(static_cast<char>(sack >> (i * 8)));
+      ack_link.send(ack_buf, now);
+    });
+    ack_link.deliver(now, [&](const buffer_type& buf) {
+      uint64_t sack = 0;
+      for (int i = 0; i < 8; ++i)
+        sack |= uint64_t{static_cast<uint8_t>(buf[2 + i])} << (i * 8);
+      win.ack(seq_of(buf), sack, now, send);
+    });
+    auto deadline = win.deadline();
+    if (deadline && *deadline <= now)
+      win.timeout(now, send);
+  }
+  CAF_REQUIRE_EQUAL(delivered.size(), total);
+  for (sequence_type i = 0; i < total; ++i)
+    CAF_CHECK_EQUAL(delivered[i], i);
+  CAF_CHECK(win.empty());
+  CAF_CHECK_NOT_EQUAL(win.retransmissions(), 0u);
+  CAF_MESSAGE("retransmissions: " << win.retransmissions());
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()